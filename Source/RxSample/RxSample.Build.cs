@@ -17,5 +17,8 @@ public class RxSample : ModuleRules
 		bEnableUndefinedIdentifierWarnings = false;
 
 		PrivateIncludePaths.Add(Path.Combine(ThirdPartyPath, "RxCpp"));
+
+		// 모든 스트림이 게임 스레드에서만 구독되고 해제되므로 원자적 참조 카운트를 쓰지 않는다
+		PrivateDefinitions.Add("RXCPP_THREAD_CONFINED=1");
 	}
 }
@@ -10,6 +10,8 @@
 #include "GameFramework/SpringArmComponent.h"
 
 rxcpp::schedulers::run_loop RunLoop;
+rxcpp::schedulers::frame_clock FrameClock;
+rxcpp::subjects::frame_input<bool> ClickInput(FrameClock);
 
 
 ARxSamplePlayerController::ARxSamplePlayerController()
@@ -41,6 +43,12 @@ void ARxSamplePlayerController::PlayerTick(float DeltaTime)
 	if (!RunLoop.empty() && RunLoop.peek().when < RunLoop.now())
 		RunLoop.dispatch();
 
+	// 지난 프레임 동안 들어온 클릭을 발생 시각 순서대로 이번 프레임 안에 배치한다.
+	ClickInput.flush(DeltaTime, FPlatformTime::Seconds());
+
+	// 프레임 시간 기반 타이머(throttle, delay)는 OS 시계 대신 DeltaTime 으로만 진행한다.
+	FrameClock.advance(DeltaTime);
+
 	Super::PlayerTick(DeltaTime);
 /*
 	if(bInputPressed)
@@ -131,6 +139,7 @@ void ARxSamplePlayerController::OnSetDestinationPressed()
 	// Just in case the character was moving because of a previous short press we stop it
 	StopMovement();
 
+	ClickInput.push(true, FPlatformTime::Seconds());
 	Clicked.get_subscriber().on_next(true);
 }
 
@@ -153,6 +162,7 @@ void ARxSamplePlayerController::OnSetDestinationReleased()
 		UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, FXCursor, HitLocation, FRotator::ZeroRotator, FVector(1.f, 1.f, 1.f), true, true, ENCPoolMethod::None, true);
 	}
 
+	ClickInput.push(false, FPlatformTime::Seconds());
 	Clicked.get_subscriber().on_next(false);
 }
 
@@ -249,47 +259,32 @@ void ARxSamplePlayerController::SubscribeMoveLog()
 
 void ARxSamplePlayerController::SubscribeMoveCommand()
 {
-	// 다른 Rx 구현체와는 달리 RxCpp에는 Throttle, Buffer_Toggle(Buffer의 closingSelector 버전)이 구현되어 있지 않다.
-	// 따라서 대신 throttle 은 외부 코드 반영, buffer_toggle은 window_toggle 로 대체하여 우회로 구현하였다.
-	// 여러모로 적절한 구현은 아니지만 향후 구현이 필요한 operator 참고 및 예제 차원에서 일단 남겨둔다.
+	// 예전에는 throttle, distinct_until_changed, window_toggle, take(2) 를 엮어 더블 클릭을 판별했지만
+	// 클릭마다 subject, 구독, 타이머가 새로 만들어졌다.
+	// multi_click 은 눌림 상태만 보고 연속 클릭 횟수(1, 2)를 바로 내보내므로 타이머도 할당도 없다.
 	auto DoubleClickPeriod = std::chrono::milliseconds(200);
 
 	auto MainThread = rxcpp::observe_on_run_loop(RunLoop);
+	auto FrameThread = rxcpp::identity_frame_clock(FrameClock);
 	//auto WorkThread = rxcpp::synchronize_new_thread();
 
-	auto ClickStream = Tick.get_observable()
-		.map([this](float DeltaTime) { return bInputPressed; });
+	// 틱마다 bInputPressed 를 샘플링하면 한 프레임 안의 눌림/뗌이 사라지므로 입력 이벤트를 그대로 쓴다.
+	auto ClickStream = ClickInput.get_observable();
 
-	auto FlushStream = ClickStream
-		.filter([](bool bPressed) { return bPressed == true; })
-		.throttle(DoubleClickPeriod);
-
-	auto WindowStream = ClickStream
-		.distinct_until_changed()
-		.window_toggle(
-			FlushStream,
-			[=](bool bPressed) {
-				return FlushStream
-					.delay(DoubleClickPeriod);
-			}
-	);
-
-	WindowStream
+	ClickStream
+		.multi_click(DoubleClickPeriod, 2, FrameThread)
 		.observe_on(MainThread)
-		.subscribe([MainThread, this](rxcpp::observable<bool> ClickWindow)
+		.subscribe([this](std::size_t ClickCount)
 			{
-				MoveToMouseCursor();
+				if (ClickCount == 1)
+				{
+					MoveToMouseCursor();
+					return;
+				}
 
-				ClickWindow
-					.filter([](bool bPressed) { return bPressed == true; })
-					.take(2)
-					.observe_on(MainThread)
-					.subscribe([this](bool bPressed)
-						{
-							GEngine->AddOnScreenDebugMessage(-1, 0.5f, FColor::Yellow, FString::Printf(TEXT("Double clicked!")));
+				GEngine->AddOnScreenDebugMessage(-1, 0.5f, FColor::Yellow, FString::Printf(TEXT("Double clicked!")));
 
-							GetCharacter()->GetCharacterMovement()->MaxWalkSpeed = RunSpeed;
-						});
+				GetCharacter()->GetCharacterMovement()->MaxWalkSpeed = RunSpeed;
 			});
 }
 
@@ -303,19 +298,20 @@ void ARxSamplePlayerController::SubscribeCameraCommand()
 		.filter([](uint32 bDown) { return bDown == 1; });
 	auto TriggerEnd = Stream
 		.filter([](uint32 bDown) { return bDown == 0; });
+	// 드래그마다 재구독하지 않고 게이트만 열고 닫는다
 	auto CameraMoveStream = Tick.get_observable()
-		.skip_until(TriggerStart)
+		.while_active(TriggerStart, TriggerEnd)
 		.map([this](float DeltaTime)
 			{
 				FVector2D Pos;
 				GetInputMouseDelta(Pos.X, Pos.Y);
 				return MoveTemp(Pos);
 			}
-		)
-		.take_until(TriggerEnd)
-				.repeat();
+		);
+	// 체인의 상태를 한 블록에 모아 할당한다
+	rxcpp::subscription_arena Arena;
 			CameraMoveStream
-				.subscribe([this](const FVector2D& V)
+				.subscribe(Arena, [this](const FVector2D& V)
 					{
 						if (ARxSampleCharacter* MyPawn = Cast<ARxSampleCharacter>(GetPawn()))
 						{
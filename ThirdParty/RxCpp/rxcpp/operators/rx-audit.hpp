@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-audit.hpp
+
+    \brief  Return an observable that, after a value arrives, waits for the period and then emits the latest value.
+
+    \tparam Duration      the type of the time interval
+    \tparam Coordination  the type of the scheduler (optional)
+
+    \param period        the time from the first value of a window to the end of that window
+    \param coordination  the scheduler that emits at the end of each window (optional)
+
+    \return  Observable that emits the latest value at the end of each window, and that
+             emits the pending value before it completes.
+
+    \note A window only starts when a value arrives and it schedules exactly one action.
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_AUDIT_HPP)
+#define RXCPP_OPERATORS_RX_AUDIT_HPP
+
+#include "../rx-includes.hpp"
+#include "rx-throttle_last-audit-common.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct audit_invalid_arguments {};
+
+template<class... AN>
+struct audit_invalid : public rxo::operator_base<audit_invalid_arguments<AN...>> {
+    using type = observable<audit_invalid_arguments<AN...>, audit_invalid<AN...>>;
+};
+template<class... AN>
+using audit_invalid_t = typename audit_invalid<AN...>::type;
+
+namespace audit {
+  // a window starts with the first value after the previous window ended
+  struct window_policy {
+    template<class TimePoint, class Duration>
+    static TimePoint window_end(TimePoint, TimePoint now, Duration period) {
+      return now + period;
+    }
+  };
+
+  template<class T, class Duration, class Coordination>
+  using trailing = ::rxcpp::operators::detail::throttle_last_audit_common::trailing
+    <T, Duration, Coordination, window_policy>;
+}
+
+}
+
+/*! @copydoc rx-audit.hpp
+*/
+template<class... AN>
+auto audit(AN&&... an)
+    ->      operator_factory<audit_tag, AN...> {
+     return operator_factory<audit_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<audit_tag>
+{
+    template<class Observable, class Duration,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            rxu::is_duration<Duration>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class Audit = rxo::detail::audit::trailing<SourceValue, rxu::decay_t<Duration>, identity_one_worker>>
+    static auto member(Observable&& o, Duration&& d)
+        -> decltype(o.template lift<SourceValue>(Audit(std::forward<Duration>(d), identity_current_thread()))) {
+        return      o.template lift<SourceValue>(Audit(std::forward<Duration>(d), identity_current_thread()));
+    }
+
+    template<class Observable, class Coordination, class Duration,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_coordination<Coordination>,
+            rxu::is_duration<Duration>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class Audit = rxo::detail::audit::trailing<SourceValue, rxu::decay_t<Duration>, rxu::decay_t<Coordination>>>
+    static auto member(Observable&& o, Coordination&& cn, Duration&& d)
+        -> decltype(o.template lift<SourceValue>(Audit(std::forward<Duration>(d), std::forward<Coordination>(cn)))) {
+        return      o.template lift<SourceValue>(Audit(std::forward<Duration>(d), std::forward<Coordination>(cn)));
+    }
+
+    template<class Observable, class Coordination, class Duration,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_coordination<Coordination>,
+            rxu::is_duration<Duration>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class Audit = rxo::detail::audit::trailing<SourceValue, rxu::decay_t<Duration>, rxu::decay_t<Coordination>>>
+    static auto member(Observable&& o, Duration&& d, Coordination&& cn)
+        -> decltype(o.template lift<SourceValue>(Audit(std::forward<Duration>(d), std::forward<Coordination>(cn)))) {
+        return      o.template lift<SourceValue>(Audit(std::forward<Duration>(d), std::forward<Coordination>(cn)));
+    }
+
+    template<class... AN>
+    static operators::detail::audit_invalid_t<AN...> member(const AN&...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "audit takes (optional Coordination, required Duration) or (required Duration, optional Coordination)");
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,258 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-coalesce_until.hpp
+
+    \brief For each item from the trigger observable, emit the items that the source observable sent since the previous trigger folded into one item.
+
+    \tparam TriggerObservable  the type of the trigger observable
+    \tparam Reducer            the type of the folding function
+    \tparam Coordination       the type of the scheduler (optional)
+
+    \param trigger       the observable whose items close each group, eg. the frame tick
+    \param reducer       folds the next item into the accumulated one. The signature should be equivalent to
+                         either void reducer(T& acc, const T& item) to update acc in place, or T reducer(T acc, const T& item).
+    \param coordination  the scheduler to synchronize the source and trigger (optional)
+
+    \return  Observable that emits one folded item for each trigger item that follows at least one source item.
+             A group that is still open when the source completes is emitted before on_completed.
+
+    \note The first item of a group is copied into the accumulator, the following items are folded into it. Nothing
+          is buffered.
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_COALESCE_UNTIL_HPP)
+#define RXCPP_OPERATORS_RX_COALESCE_UNTIL_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct coalesce_until_invalid_arguments {};
+
+template<class... AN>
+struct coalesce_until_invalid : public rxo::operator_base<coalesce_until_invalid_arguments<AN...>> {
+    using type = observable<coalesce_until_invalid_arguments<AN...>, coalesce_until_invalid<AN...>>;
+};
+template<class... AN>
+using coalesce_until_invalid_t = typename coalesce_until_invalid<AN...>::type;
+
+template<class T, class Reducer>
+struct is_in_place_reducer
+{
+    struct not_void {};
+    template<class CT, class CR>
+    static auto check(int) -> decltype((*(CR*)nullptr)(*(CT*)nullptr, *(const CT*)nullptr));
+    template<class CT, class CR>
+    static not_void check(...);
+
+    static const bool value = std::is_same<decltype(check<T, Reducer>(0)), void>::value;
+};
+
+template<class T, class Reducer>
+void coalesce_fold(T& acc, const T& v, const Reducer& r, std::true_type) {
+    r(acc, v);
+}
+template<class T, class Reducer>
+void coalesce_fold(T& acc, const T& v, const Reducer& r, std::false_type) {
+    acc = r(std::move(acc), v);
+}
+
+template<class T, class Observable, class TriggerObservable, class Reducer, class Coordination>
+struct coalesce_until : public operator_base<T>
+{
+    typedef rxu::decay_t<T> value_type;
+    typedef rxu::decay_t<Observable> source_type;
+    typedef rxu::decay_t<TriggerObservable> trigger_source_type;
+    typedef rxu::decay_t<Reducer> reducer_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef std::integral_constant<bool, is_in_place_reducer<value_type, reducer_type>::value> in_place;
+
+    struct values
+    {
+        values(source_type s, trigger_source_type t, reducer_type r, coordination_type sf)
+            : source(std::move(s))
+            , trigger(std::move(t))
+            , reducer(std::move(r))
+            , coordination(std::move(sf))
+        {
+        }
+        source_type source;
+        trigger_source_type trigger;
+        reducer_type reducer;
+        coordination_type coordination;
+    };
+    values initial;
+
+    coalesce_until(source_type s, trigger_source_type t, reducer_type r, coordination_type sf)
+        : initial(std::move(s), std::move(t), std::move(r), std::move(sf))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber s) const {
+
+        typedef Subscriber output_type;
+        struct coalesce_until_state_type
+            : public std::enable_shared_from_this<coalesce_until_state_type>
+            , public values
+        {
+            coalesce_until_state_type(const values& i, coordinator_type coor, const output_type& oarg)
+                : values(i)
+                , coordinator(std::move(coor))
+                , out(oarg)
+            {
+                out.add(trigger_lifetime);
+                out.add(source_lifetime);
+            }
+            void flush() {
+                if (acc.empty()) {
+                    return;
+                }
+                auto v = std::move(*acc);
+                acc.reset();
+                out.on_next(std::move(v));
+            }
+            composite_subscription trigger_lifetime;
+            composite_subscription source_lifetime;
+            coordinator_type coordinator;
+            output_type out;
+            rxu::maybe<value_type> acc;
+        };
+
+        auto coordinator = initial.coordination.create_coordinator(s.get_subscription());
+
+        // take a copy of the values for each subscription
+        auto state = rxu::make_arena_shared<coalesce_until_state_type>(initial, std::move(coordinator), std::move(s));
+
+        auto trigger = on_exception(
+            [&](){return state->coordinator.in(state->trigger);},
+            state->out);
+        if (trigger.empty()) {
+            return;
+        }
+
+        auto source = on_exception(
+            [&](){return state->coordinator.in(state->source);},
+            state->out);
+        if (source.empty()) {
+            return;
+        }
+
+        auto sinkTrigger = make_subscriber<typename trigger_source_type::value_type>(
+        // share parts of subscription
+            state->out,
+        // new lifetime
+            state->trigger_lifetime,
+        // on_next
+            [state](const typename trigger_source_type::value_type&) {
+                state->flush();
+            },
+        // on_error
+            [state](rxu::error_ptr e) {
+                state->out.on_error(e);
+            },
+        // on_completed
+            []() {
+            }
+        );
+        auto selectedSinkTrigger = on_exception(
+            [&](){return state->coordinator.out(sinkTrigger);},
+            state->out);
+        if (selectedSinkTrigger.empty()) {
+            return;
+        }
+        trigger->subscribe(std::move(selectedSinkTrigger.get()));
+
+        auto sinkSource = make_subscriber<T>(
+        // split subscription lifetime
+            state->source_lifetime,
+        // on_next
+            [state](const value_type& t) {
+                if (state->acc.empty()) {
+                    state->acc.reset(t);
+                    return;
+                }
+                on_exception(
+                    [&](){
+                        coalesce_fold(*state->acc, t, state->reducer, in_place());
+                        return true;
+                    },
+                    state->out);
+            },
+        // on_error
+            [state](rxu::error_ptr e) {
+                state->out.on_error(e);
+            },
+        // on_completed
+            [state]() {
+                state->flush();
+                state->out.on_completed();
+            }
+        );
+        auto selectedSinkSource = on_exception(
+            [&](){return state->coordinator.out(sinkSource);},
+            state->out);
+        if (selectedSinkSource.empty()) {
+            return;
+        }
+        source->subscribe(std::move(selectedSinkSource.get()));
+    }
+};
+
+}
+
+/*! @copydoc rx-coalesce_until.hpp
+*/
+template<class... AN>
+auto coalesce_until(AN&&... an)
+    ->     operator_factory<coalesce_until_tag, AN...> {
+    return operator_factory<coalesce_until_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<coalesce_until_tag>
+{
+    template<class Observable, class TriggerObservable, class Reducer,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            all_observables<Observable, TriggerObservable>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class CoalesceUntil = rxo::detail::coalesce_until<SourceValue, rxu::decay_t<Observable>, rxu::decay_t<TriggerObservable>, rxu::decay_t<Reducer>, identity_one_worker>,
+        class Value = rxu::value_type_t<CoalesceUntil>,
+        class Result = observable<Value, CoalesceUntil>>
+    static Result member(Observable&& o, TriggerObservable&& t, Reducer&& r) {
+        return Result(CoalesceUntil(std::forward<Observable>(o), std::forward<TriggerObservable>(t), std::forward<Reducer>(r), identity_current_thread()));
+    }
+
+    template<class Observable, class TriggerObservable, class Reducer, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            all_observables<Observable, TriggerObservable>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class CoalesceUntil = rxo::detail::coalesce_until<SourceValue, rxu::decay_t<Observable>, rxu::decay_t<TriggerObservable>, rxu::decay_t<Reducer>, rxu::decay_t<Coordination>>,
+        class Value = rxu::value_type_t<CoalesceUntil>,
+        class Result = observable<Value, CoalesceUntil>>
+    static Result member(Observable&& o, TriggerObservable&& t, Reducer&& r, Coordination&& cn) {
+        return Result(CoalesceUntil(std::forward<Observable>(o), std::forward<TriggerObservable>(t), std::forward<Reducer>(r), std::forward<Coordination>(cn)));
+    }
+
+    template<class... AN>
+    static operators::detail::coalesce_until_invalid_t<AN...> member(AN...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "coalesce_until takes (TriggerObservable, Reducer, optional Coordination)");
+    }
+};
+
+}
+
+#endif
@@ -227,7 +227,7 @@ struct combine_latest : public operator_base<rxu::value_type_t<combine_latest_tr
         auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
 
         // take a copy of the values for each subscription
-        auto state = std::make_shared<combine_latest_state_type>(initial, std::move(coordinator), std::move(scbr));
+        auto state = rxu::make_arena_shared<combine_latest_state_type>(initial, std::move(coordinator), std::move(scbr));
 
         subscribe_all(state, typename rxu::values_from<int, sizeof...(ObservableN)>::type());
     }
@@ -226,7 +226,7 @@ struct concat_map
         auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
 
         // take a copy of the values for each subscription
-        auto state = std::make_shared<concat_map_state_type>(initial, std::move(coordinator), std::move(scbr));
+        auto state = rxu::make_arena_shared<concat_map_state_type>(initial, std::move(coordinator), std::move(scbr));
 
         state->sourceLifetime = composite_subscription();
 
@@ -82,7 +82,7 @@ struct debounce
                 , dest(std::move(d))
                 , coordinator(std::move(c))
                 , worker(coordinator.get_worker())
-                , index(0)
+                , armed(false)
             {
             }
 
@@ -90,7 +90,8 @@ struct debounce
             dest_type dest;
             coordinator_type coordinator;
             rxsc::worker worker;
-            mutable std::size_t index;
+            mutable rxsc::scheduler::clock_type::time_point deadline;
+            mutable bool armed;
             mutable rxu::maybe<value_type> value;
         };
         typedef std::shared_ptr<debounce_subscriber_values> state_type;
@@ -121,11 +122,21 @@ struct debounce
             });
         }
 
-        static std::function<void(const rxsc::schedulable&)> produce_item(std::size_t id, state_type state) {
-            auto produce = [id, state](const rxsc::schedulable&) {
-                if(id != state->index)
+        // at most one timer is pending. each value only moves the deadline,
+        // a timer that fires before the deadline re-arms itself for it.
+        static std::function<void(const rxsc::schedulable&)> produce_item(state_type state) {
+            auto produce = [state](const rxsc::schedulable& self) {
+                if (state->value.empty()) {
+                    state->armed = false;
                     return;
+                }
+
+                if (state->worker.now() < state->deadline) {
+                    self.schedule(state->deadline);
+                    return;
+                }
 
+                state->armed = false;
                 state->dest.on_next(std::move(*state->value));
                 state->value.reset();
             };
@@ -145,11 +156,17 @@ struct debounce
             auto vAsShared = std::make_shared<T>(std::forward<U>(v));
             auto localState = state;
             auto work = [vAsShared, localState](const rxsc::schedulable&) {
-                auto new_id = ++localState->index;
-                auto produce_time = localState->worker.now() + localState->period;
-
+                localState->deadline = localState->worker.now() + localState->period;
                 localState->value.reset(std::move(*vAsShared));
-                localState->worker.schedule(produce_time, produce_item(new_id, localState));
+
+                if (!localState->armed) {
+                    auto produce = produce_item(localState);
+                    if (!produce) {
+                        return;
+                    }
+                    localState->armed = true;
+                    localState->worker.schedule(localState->deadline, produce);
+                }
             };
             auto selectedWork = on_exception(
                 [&](){return localState->coordinator.act(work);},
@@ -180,6 +197,7 @@ struct debounce
             auto work = [localState](const rxsc::schedulable&) {
                 if(!localState->value.empty()) {
                     localState->dest.on_next(*localState->value);
+                    localState->value.reset();
                 }
                 localState->dest.on_completed();
             };
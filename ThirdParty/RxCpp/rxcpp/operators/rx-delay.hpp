@@ -73,6 +73,15 @@ struct delay
         typedef rxu::decay_t<Subscriber> dest_type;
         typedef observer<T, this_type> observer_type;
 
+        typedef rxsc::scheduler::clock_type::time_point time_point_type;
+
+        // a value that is waiting for its due time, an empty value is on_completed.
+        struct delayed_item
+        {
+            time_point_type due;
+            rxu::maybe<value_type> value;
+        };
+
         struct delay_subscriber_values : public delay_values
         {
             delay_subscriber_values(composite_subscription cs, dest_type d, delay_values v, coordinator_type c)
@@ -82,6 +91,8 @@ struct delay
                 , coordinator(std::move(c))
                 , worker(coordinator.get_worker())
                 , expected(worker.now())
+                , armed(false)
+                , source_done(false)
             {
             }
             composite_subscription cs;
@@ -89,18 +100,22 @@ struct delay
             coordinator_type coordinator;
             rxsc::worker worker;
             rxsc::scheduler::clock_type::time_point expected;
+            mutable std::mutex lock;
+            mutable std::deque<delayed_item> queue;
+            mutable bool armed;
+            // the source side was unsubscribed, dispose once the queue is empty.
+            mutable bool source_done;
         };
-        std::shared_ptr<delay_subscriber_values> state;
+        typedef std::shared_ptr<delay_subscriber_values> state_type;
+        state_type state;
 
         delay_observer(composite_subscription cs, dest_type d, delay_values v, coordinator_type c)
-            : state(std::make_shared<delay_subscriber_values>(delay_subscriber_values(std::move(cs), std::move(d), v, std::move(c))))
+            : state(std::make_shared<delay_subscriber_values>(std::move(cs), std::move(d), v, std::move(c)))
         {
             auto localState = state;
 
             auto disposer = [=](const rxsc::schedulable&){
-                localState->cs.unsubscribe();
-                localState->dest.unsubscribe();
-                localState->worker.unsubscribe();
+                dispose(localState);
             };
             auto selectedDisposer = on_exception(
                 [&](){return localState->coordinator.act(disposer);},
@@ -113,16 +128,62 @@ struct delay
                 localState->worker.schedule(selectedDisposer.get());
             });
             localState->cs.add([=](){
-                localState->worker.schedule(localState->worker.now() + localState->period, selectedDisposer.get());
+                std::unique_lock<std::mutex> guard(localState->lock);
+                localState->source_done = true;
+                if (localState->armed) {
+                    // the drain disposes after the queued items
+                    return;
+                }
+                guard.unlock();
+                localState->worker.schedule(selectedDisposer.get());
             });
         }
 
-        template<typename U>
-        void on_next(U&& v) const {
+        static void dispose(const state_type& state) {
+            state->cs.unsubscribe();
+            state->dest.unsubscribe();
+            state->worker.unsubscribe();
+        }
+
+        // the delay is fixed, so items become due in the order they arrive.
+        // one timer is armed for the head of the queue and the drain re-arms
+        // it for the next head, instead of one timer per item.
+        static void drain(const state_type& state, const rxsc::schedulable& self) {
+            std::unique_lock<std::mutex> guard(state->lock);
+            while (!state->queue.empty()) {
+                auto& head = state->queue.front();
+                if (state->worker.now() < head.due) {
+                    auto due = head.due;
+                    guard.unlock();
+                    self.schedule(due);
+                    return;
+                }
+                auto value = std::move(head.value);
+                state->queue.pop_front();
+                guard.unlock();
+                if (value.empty()) {
+                    state->dest.on_completed();
+                } else {
+                    state->dest.on_next(std::move(*value));
+                }
+                guard.lock();
+            }
+            state->armed = false;
+            if (state->source_done) {
+                guard.unlock();
+                dispose(state);
+            }
+        }
+
+        static void push(const state_type& state, delayed_item item) {
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->queue.push_back(std::move(item));
+            if (state->armed) {
+                return;
+            }
             auto localState = state;
-            auto vAsShared  = std::make_shared<T>(std::forward<U>(v));
-            auto work = [vAsShared, localState](const rxsc::schedulable&){
-                localState->dest.on_next(std::move(*vAsShared));
+            auto work = [localState](const rxsc::schedulable& self){
+                drain(localState, self);
             };
             auto selectedWork = on_exception(
                 [&](){return localState->coordinator.act(work);},
@@ -130,7 +191,18 @@ struct delay
             if (selectedWork.empty()) {
                 return;
             }
-            localState->worker.schedule(localState->worker.now() + localState->period, selectedWork.get());
+            state->armed = true;
+            auto due = state->queue.front().due;
+            guard.unlock();
+            state->worker.schedule(due, selectedWork.get());
+        }
+
+        template<typename U>
+        void on_next(U&& v) const {
+            delayed_item item;
+            item.due = state->worker.now() + state->period;
+            item.value.reset(std::forward<U>(v));
+            push(state, std::move(item));
         }
 
         void on_error(rxu::error_ptr e) const {
@@ -148,17 +220,9 @@ struct delay
         }
 
         void on_completed() const {
-            auto localState = state;
-            auto work = [localState](const rxsc::schedulable&){
-                localState->dest.on_completed();
-            };
-            auto selectedWork = on_exception(
-                [&](){return localState->coordinator.act(work);},
-                localState->dest);
-            if (selectedWork.empty()) {
-                return;
-            }
-            localState->worker.schedule(localState->worker.now() + localState->period, selectedWork.get());
+            delayed_item item;
+            item.due = state->worker.now() + state->period;
+            push(state, std::move(item));
         }
 
         static subscriber<T, observer_type> make(dest_type d, delay_values v) {
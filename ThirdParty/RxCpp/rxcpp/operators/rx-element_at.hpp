@@ -83,7 +83,7 @@ struct element_at {
         }
         void on_completed() const {
             if(current <= this->index) {
-                dest.on_error(rxu::make_error_ptr(std::range_error("index is out of bounds")));
+                dest.on_error(rxu::make_static_error_ptr<std::range_error>("index is out of bounds"));
             }
         }
 
@@ -12,6 +12,8 @@
 
     \return  Observable that emits only those items emitted by the source observable that the filter evaluates as true.
 
+    A filter applied after map or filter is fused with it into one observer, see rx-fuse.hpp.
+
     \sample
     \snippet filter.cpp filter sample
     \snippet output.txt filter sample
@@ -114,6 +116,8 @@ template<>
 struct member_overload<filter_tag>
 {
     template<class Observable, class Predicate,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            rxu::negation<rxo::detail::is_fusable<rxu::decay_t<Observable>>>>,
         class SourceValue = rxu::value_type_t<Observable>,
         class Filter = rxo::detail::filter<SourceValue, rxu::decay_t<Predicate>>>
     static auto member(Observable&& o, Predicate&& p)
@@ -121,6 +125,17 @@ struct member_overload<filter_tag>
         return      o.template lift<SourceValue>(Filter(std::forward<Predicate>(p)));
     }
 
+    // Observable ends in map or filter, see rx-fuse.hpp
+    template<class Observable, class Predicate,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            rxo::detail::is_fusable<rxu::decay_t<Observable>>>,
+        class Stage = rxo::detail::filter_stage<rxu::decay_t<Predicate>>,
+        class Fuse = rxo::detail::fuse_traits<Observable, Stage>,
+        class Value = typename Fuse::value_type>
+    static typename Fuse::type member(Observable&& o, Predicate&& p) {
+        return Fuse::make(o, Stage(std::forward<Predicate>(p)));
+    }
+
     template<class... AN>
     static operators::detail::filter_invalid_t<AN...> member(const AN&...) {
         std::terminate();
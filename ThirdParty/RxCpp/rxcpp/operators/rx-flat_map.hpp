@@ -14,11 +14,14 @@
     \param  s   a function that returns an observable for each item emitted by the source observable.
     \param  rs  a function that combines one item emitted by each of the source and collection observables and returns an item to be emitted by the resulting observable (optional).
     \param  cn  the scheduler to synchronize sources from different contexts (optional).
+    \param  max_concurrent  the most produced observables that are subscribed at once (optional, only with CollectionSelector).
 
     \return  Observable that emits the results of applying a function to a pair of values emitted by the source observable and the collection observable.
 
     Observables, produced by the CollectionSelector, are merged. There is another operator rxcpp::observable<T,SourceType>::flat_map that works similar but concatenates the observables.
 
+    flat_map(s, max_concurrent) is map(s).merge(max_concurrent), see rx-merge.hpp.
+
     \sample
     \snippet flat_map.cpp flat_map sample
     \snippet output.txt flat_map sample
@@ -148,7 +151,7 @@ struct flat_map
         auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
 
         // take a copy of the values for each subscription
-        auto state = std::make_shared<state_type>(initial, std::move(coordinator), std::move(scbr));
+        auto state = rxu::make_arena_shared<state_type>(initial, std::move(coordinator), std::move(scbr));
 
         composite_subscription outercs;
 
@@ -293,6 +296,19 @@ struct member_overload<flat_map_tag>
         return Result(FlatMap(std::forward<Observable>(o), std::forward<CollectionSelector>(s), ResultSelectorType(), std::forward<Coordination>(cn)));
     }
 
+    template<class Observable, class CollectionSelector, class Count,
+        class CollectionSelectorType = rxu::decay_t<CollectionSelector>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class CollectionType = rxu::result_of_t<CollectionSelectorType(SourceValue)>,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            all_observables<Observable, CollectionType>,
+            std::is_integral<rxu::decay_t<Count>>>
+    >
+    static auto member(Observable&& o, CollectionSelector&& s, Count&& c)
+        -> decltype(o.map(std::forward<CollectionSelector>(s)).merge(static_cast<std::size_t>(c))) {
+        return      o.map(std::forward<CollectionSelector>(s)).merge(static_cast<std::size_t>(c));
+    }
+
     template<class Observable, class CollectionSelector, class ResultSelector,
         class IsCoordination = is_coordination<ResultSelector>,
         class CollectionSelectorType = rxu::decay_t<CollectionSelector>,
@@ -300,7 +316,8 @@ struct member_overload<flat_map_tag>
         class CollectionType = rxu::result_of_t<CollectionSelectorType(SourceValue)>,
         class Enabled = rxu::enable_if_all_true_type_t<
             all_observables<Observable, CollectionType>,
-            rxu::negation<IsCoordination>>,
+            rxu::negation<IsCoordination>,
+            rxu::negation<std::is_integral<rxu::decay_t<ResultSelector>>>>,
         class FlatMap = rxo::detail::flat_map<rxu::decay_t<Observable>, rxu::decay_t<CollectionSelector>, rxu::decay_t<ResultSelector>, identity_one_worker>,
         class CollectionValueType = rxu::value_type_t<CollectionType>,
         class ResultSelectorType = rxu::decay_t<ResultSelector>,
@@ -332,7 +349,7 @@ struct member_overload<flat_map_tag>
     static operators::detail::flat_map_invalid_t<AN...> member(AN...) {
         std::terminate();
         return {};
-        static_assert(sizeof...(AN) == 10000, "flat_map takes (CollectionSelector, optional ResultSelector, optional Coordination)");
+        static_assert(sizeof...(AN) == 10000, "flat_map takes (CollectionSelector, optional ResultSelector, optional Coordination) or (CollectionSelector, MaxConcurrent)");
     }
 };
 
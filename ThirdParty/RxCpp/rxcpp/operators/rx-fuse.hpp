@@ -0,0 +1,282 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-fuse.hpp
+
+    \brief Collapses adjacent map and filter operators into one observer.
+
+    When map or filter is applied to an observable that is itself the result of map or filter, the two are
+    not lifted separately. The selectors and predicates become the stages of one fused operator, which
+    creates a single observer for the whole run. source.map(f).filter(g).map(h) calls f, g and h from one
+    on_next, with one subscriber and one is_subscribed() check, instead of three nested subscribers.
+
+    The stages run in order and an exception from any of them is delivered to on_error, as it is when
+    the operators are separate. Only the selectors and predicates are guarded, the on_next of the
+    subscriber after the run is not. Other operators, and as_dynamic(), end the run.
+
+    Define RXCPP_NO_OPERATOR_FUSION to lift every map and filter separately.
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_FUSE_HPP)
+#define RXCPP_OPERATORS_RX_FUSE_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class T, class Selector>
+struct map;
+
+template<class T, class Predicate>
+struct filter;
+
+template<class Selector>
+struct map_stage
+{
+    typedef rxu::decay_t<Selector> select_type;
+    mutable select_type selector;
+
+    explicit map_stage(select_type s)
+        : selector(std::move(s))
+    {
+    }
+
+    template<class V>
+    struct result
+    {
+        typedef rxu::decay_t<decltype((*(select_type*)nullptr)(*(rxu::decay_t<V>*)nullptr))> type;
+    };
+
+    template<class Next, class Dest, class V>
+    void operator()(const Next& next, const Dest& dest, V&& v) const {
+        typedef decltype(selector(std::forward<V>(v))) selected_type;
+        select(next, dest, std::forward<V>(v), std::is_lvalue_reference<selected_type>());
+    }
+
+    // a selector that returns a reference passes it on without a copy
+    template<class Next, class Dest, class V>
+    void select(const Next& next, const Dest& dest, V&& v, std::true_type) const {
+        auto selected = on_exception(
+            [&](){ return std::addressof(this->selector(std::forward<V>(v))); },
+            dest);
+        if (selected.empty()) {
+            return;
+        }
+        next(*selected.get());
+    }
+    template<class Next, class Dest, class V>
+    void select(const Next& next, const Dest& dest, V&& v, std::false_type) const {
+        auto selected = on_exception(
+            [&](){ return this->selector(std::forward<V>(v)); },
+            dest);
+        if (selected.empty()) {
+            return;
+        }
+        next(std::move(selected.get()));
+    }
+};
+
+template<class Predicate>
+struct filter_stage
+{
+    typedef rxu::decay_t<Predicate> test_type;
+    mutable test_type test;
+
+    explicit filter_stage(test_type t)
+        : test(std::move(t))
+    {
+    }
+
+    template<class V>
+    struct result
+    {
+        typedef rxu::decay_t<V> type;
+    };
+
+    template<class Next, class Dest, class V>
+    void operator()(const Next& next, const Dest& dest, V&& v) const {
+        auto passed = on_exception(
+            [&](){ return this->test(rxu::as_const(v)); },
+            dest);
+        if (passed.empty() || !passed.get()) {
+            return;
+        }
+        next(std::forward<V>(v));
+    }
+};
+
+template<class V, class... StageN>
+struct fused_result;
+
+template<class V>
+struct fused_result<V>
+{
+    typedef V type;
+};
+
+template<class V, class Stage0, class... StageN>
+struct fused_result<V, Stage0, StageN...>
+{
+    typedef typename fused_result<typename Stage0::template result<V>::type, StageN...>::type type;
+};
+
+template<class T, class... StageN>
+struct fused
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef typename fused_result<source_value_type, StageN...>::type value_type;
+    typedef std::tuple<StageN...> stages_type;
+    stages_type stages;
+
+    explicit fused(stages_type s)
+        : stages(std::move(s))
+    {
+    }
+
+    template<class Stage>
+    fused<T, StageN..., Stage> then(Stage s) const {
+        return fused<T, StageN..., Stage>(std::tuple_cat(stages, std::make_tuple(std::move(s))));
+    }
+
+    template<class Subscriber>
+    struct fused_observer
+    {
+        typedef fused_observer<Subscriber> this_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<source_value_type, this_type> observer_type;
+        dest_type dest;
+        stages_type stages;
+
+        fused_observer(dest_type d, stages_type s)
+            : dest(std::move(d))
+            , stages(std::move(s))
+        {
+        }
+
+        // passes the value of stage I - 1 to stage I, past the last stage it reaches dest.
+        template<std::size_t I>
+        struct next
+        {
+            const this_type* that;
+
+            template<class V>
+            void operator()(V&& v) const {
+                that->step(std::integral_constant<std::size_t, I>(), std::forward<V>(v));
+            }
+        };
+
+        template<std::size_t I, class V>
+        void step(std::integral_constant<std::size_t, I>, V&& v) const {
+            std::get<I>(stages)(next<I + 1>{this}, dest, std::forward<V>(v));
+        }
+        template<class V>
+        void step(std::integral_constant<std::size_t, sizeof...(StageN)>, V&& v) const {
+            dest.on_next(std::forward<V>(v));
+        }
+
+        // each stage guards its own selector or predicate
+        template<class Value>
+        void on_next(Value&& v) const {
+            step(std::integral_constant<std::size_t, 0>(), std::forward<Value>(v));
+        }
+        void on_error(rxu::error_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            dest.on_completed();
+        }
+
+        static subscriber<source_value_type, observer_type> make(dest_type d, stages_type s) {
+            auto cs = d.get_subscription();
+            return make_subscriber<source_value_type>(std::move(cs), observer_type(this_type(std::move(d), std::move(s))));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(fused_observer<Subscriber>::make(std::move(dest), stages)) {
+        return      fused_observer<Subscriber>::make(std::move(dest), stages);
+    }
+};
+
+// the operators that can start or extend a fused run
+template<class Operator>
+struct fusion_of
+{
+    static const bool value = false;
+};
+
+#if !defined(RXCPP_NO_OPERATOR_FUSION)
+template<class T, class Selector>
+struct fusion_of<map<T, Selector>>
+{
+    static const bool value = true;
+    typedef fused<T, map_stage<Selector>> type;
+    static type make(const map<T, Selector>& m) {
+        return type(std::make_tuple(map_stage<Selector>(m.selector)));
+    }
+};
+
+template<class T, class Predicate>
+struct fusion_of<filter<T, Predicate>>
+{
+    static const bool value = true;
+    typedef fused<T, filter_stage<Predicate>> type;
+    static type make(const filter<T, Predicate>& f) {
+        return type(std::make_tuple(filter_stage<Predicate>(f.test)));
+    }
+};
+
+template<class T, class... StageN>
+struct fusion_of<fused<T, StageN...>>
+{
+    static const bool value = true;
+    typedef fused<T, StageN...> type;
+    static const type& make(const type& f) {
+        return f;
+    }
+};
+#endif
+
+template<class Observable>
+struct is_fusable
+{
+    static const bool value = false;
+};
+
+template<class T, class ResultType, class SourceOperator, class Operator>
+struct is_fusable<observable<T, lift_operator<ResultType, SourceOperator, Operator>>>
+{
+    static const bool value = fusion_of<rxu::decay_t<Operator>>::value;
+};
+
+// appends a stage to the run that ends in Observable
+template<class Observable, class Stage>
+struct fuse_traits
+{
+    typedef rxu::decay_t<Observable> observable_type;
+    typedef typename observable_type::source_operator_type lift_type;
+    typedef typename lift_type::source_operator_type source_operator_type;
+    typedef fusion_of<typename lift_type::operator_type> fusion_type;
+    typedef decltype((*(typename fusion_type::type*)nullptr).then(*(Stage*)nullptr)) fused_type;
+    typedef typename fused_type::value_type value_type;
+    typedef lift_operator<value_type, source_operator_type, fused_type> operator_type;
+    typedef observable<value_type, operator_type> type;
+
+    static type make(const observable_type& o, Stage s) {
+        return type(operator_type(o.source_operator.source, fusion_type::make(o.source_operator.chain).then(std::move(s))));
+    }
+};
+
+}
+
+}
+
+}
+
+#endif
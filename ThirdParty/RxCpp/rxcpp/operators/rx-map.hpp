@@ -12,6 +12,8 @@
 
     \return  Observable that emits the items from the source observable, transformed by the specified function.
 
+    A map applied after map or filter is fused with it into one observer, see rx-fuse.hpp.
+
     \sample
     \snippet map.cpp map sample
     \snippet output.txt map sample
@@ -121,7 +123,8 @@ struct member_overload<map_tag>
 {
     template<class Observable, class Selector,
         class Enabled = rxu::enable_if_all_true_type_t<
-            is_observable<Observable>>,
+            is_observable<Observable>,
+            rxu::negation<rxo::detail::is_fusable<rxu::decay_t<Observable>>>>,
         class ResolvedSelector = rxu::decay_t<Selector>,
         class SourceValue = rxu::value_type_t<Observable>,
         class Map = rxo::detail::map<SourceValue, ResolvedSelector>,
@@ -131,6 +134,17 @@ struct member_overload<map_tag>
         return      o.template lift<Value>(Map(std::forward<Selector>(s)));
     }
 
+    // Observable ends in map or filter, see rx-fuse.hpp
+    template<class Observable, class Selector,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            rxo::detail::is_fusable<rxu::decay_t<Observable>>>,
+        class Stage = rxo::detail::map_stage<rxu::decay_t<Selector>>,
+        class Fuse = rxo::detail::fuse_traits<Observable, Stage>>
+    static typename Fuse::type member(Observable&& o, Selector&& s) {
+        return Fuse::make(o, Stage(std::forward<Selector>(s)));
+    }
+
     template<class... AN>
     static operators::detail::map_invalid_t<AN...> member(const AN...) {
         std::terminate();
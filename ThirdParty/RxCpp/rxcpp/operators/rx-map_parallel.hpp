@@ -0,0 +1,355 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-map_parallel.hpp
+
+    \brief For each item from this observable run Selector on a worker of the coordination and emit the results, in source order unless told otherwise.
+
+    \tparam Selector      the type of the transforming function
+    \tparam Coordination  the type of the scheduler that runs Selector
+
+    \param selector       the transforming function, it is called concurrently and must not share unsynchronized state
+    \param coordination   the scheduler that provides the workers, eg. observe_on_event_loop()
+    \param max_in_flight  the most items that are transformed or waiting to be emitted at once (optional, defaults to the hardware concurrency)
+    \param ordered        true to emit the results in source order, false to emit them as they complete (optional, defaults to true)
+
+    \return  Observable that emits the result of Selector for each item of the source observable.
+
+    \note One worker is created for each slot of the window and items are dealt to them in turn. When
+          max_in_flight items are outstanding the source is blocked until the oldest result is emitted,
+          so the source must not run on one of the workers. The results are emitted one at a time from
+          the worker that completes them. An error from Selector is emitted in place of its result, an
+          error from the source is emitted as soon as the results being emitted are done.
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_MAP_PARALLEL_HPP)
+#define RXCPP_OPERATORS_RX_MAP_PARALLEL_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct map_parallel_invalid_arguments {};
+
+template<class... AN>
+struct map_parallel_invalid : public rxo::operator_base<map_parallel_invalid_arguments<AN...>> {
+    using type = observable<map_parallel_invalid_arguments<AN...>, map_parallel_invalid<AN...>>;
+};
+template<class... AN>
+using map_parallel_invalid_t = typename map_parallel_invalid<AN...>::type;
+
+inline std::size_t map_parallel_default_window() {
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+template<class T, class Selector, class Coordination>
+struct map_parallel
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Selector> select_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxu::decay_t<decltype((*(select_type*)nullptr)(*(source_value_type*)nullptr))> value_type;
+
+    struct map_parallel_values
+    {
+        map_parallel_values(select_type s, coordination_type c, std::size_t w, bool o)
+            : selector(std::move(s))
+            , coordination(std::move(c))
+            , window(w)
+            , ordered(o)
+        {
+        }
+        select_type selector;
+        coordination_type coordination;
+        std::size_t window;
+        bool ordered;
+    };
+    map_parallel_values initial;
+
+    map_parallel(select_type s, coordination_type c, std::size_t window, bool ordered)
+        : initial(std::move(s), std::move(c), window, ordered)
+    {
+        if (initial.window == 0) {
+            std::terminate();
+        }
+    }
+
+    template<class Subscriber>
+    struct map_parallel_observer
+    {
+        typedef map_parallel_observer<Subscriber> this_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<source_value_type, this_type> observer_type;
+
+        // a result that is ready to be emitted, or the error that replaced it.
+        struct result_slot
+        {
+            result_slot()
+                : ready(false)
+                , failed(false)
+            {
+            }
+            bool ready;
+            bool failed;
+            rxu::maybe<value_type> value;
+            rxu::error_ptr error;
+        };
+
+        struct map_parallel_subscriber_values : public map_parallel_values
+        {
+            map_parallel_subscriber_values(composite_subscription cs, dest_type d, map_parallel_values v)
+                : map_parallel_values(std::move(v))
+                , cs(std::move(cs))
+                , dest(std::move(d))
+                , slots(this->ordered ? this->window : 0)
+                , dispatched(0)
+                , emitted(0)
+                , emitting(false)
+                , completed(false)
+                , stopped(false)
+            {
+                dest.add(workers_lifetime);
+                for (std::size_t i = 0; i < this->window; ++i) {
+                    coordinators.push_back(this->coordination.create_coordinator(workers_lifetime));
+                    workers.push_back(coordinators.back().get_worker());
+                }
+            }
+            composite_subscription cs;
+            dest_type dest;
+            composite_subscription workers_lifetime;
+            std::vector<coordinator_type> coordinators;
+            std::vector<rxsc::worker> workers;
+
+            mutable std::mutex lock;
+            mutable std::condition_variable space;
+            // ordered results wait here for their turn, indexed by sequence % window
+            mutable std::vector<result_slot> slots;
+            // unordered results wait here in completion order
+            mutable std::deque<result_slot> done;
+            mutable std::size_t dispatched;
+            mutable std::size_t emitted;
+            mutable bool emitting;
+            mutable bool completed;
+            mutable bool stopped;
+            mutable result_slot source_error;
+        };
+        typedef std::shared_ptr<map_parallel_subscriber_values> state_type;
+        state_type state;
+
+        map_parallel_observer(composite_subscription cs, dest_type d, map_parallel_values v)
+            : state(std::make_shared<map_parallel_subscriber_values>(std::move(cs), std::move(d), std::move(v)))
+        {
+            auto localState = state;
+            localState->dest.add(localState->cs);
+            localState->dest.add([localState](){
+                std::unique_lock<std::mutex> guard(localState->lock);
+                localState->stopped = true;
+                localState->space.notify_all();
+            });
+        }
+
+        // emit the results that are ready, one thread at a time. a thread that
+        // finds another one emitting leaves its result for that thread to emit.
+        static void drain(const state_type& state) {
+            std::unique_lock<std::mutex> guard(state->lock);
+            if (state->emitting) {
+                return;
+            }
+            state->emitting = true;
+            while (!state->stopped) {
+                if (state->source_error.failed) {
+                    state->stopped = true;
+                    auto e = state->source_error.error;
+                    guard.unlock();
+                    state->dest.on_error(e);
+                    guard.lock();
+                    break;
+                }
+                result_slot next;
+                if (state->ordered) {
+                    auto& head = state->slots[state->emitted % state->window];
+                    if (!head.ready) {
+                        break;
+                    }
+                    std::swap(next, head);
+                } else {
+                    if (state->done.empty()) {
+                        break;
+                    }
+                    std::swap(next, state->done.front());
+                    state->done.pop_front();
+                }
+                ++state->emitted;
+                state->space.notify_one();
+                if (next.failed) {
+                    state->stopped = true;
+                    guard.unlock();
+                    state->dest.on_error(next.error);
+                    guard.lock();
+                    break;
+                }
+                guard.unlock();
+                state->dest.on_next(std::move(*next.value));
+                guard.lock();
+            }
+            if (!state->stopped && state->completed && state->emitted == state->dispatched) {
+                state->stopped = true;
+                guard.unlock();
+                state->dest.on_completed();
+                guard.lock();
+            }
+            state->emitting = false;
+        }
+
+        static void complete(const state_type& state, std::size_t sequence, result_slot r) {
+            {
+                std::unique_lock<std::mutex> guard(state->lock);
+                r.ready = true;
+                if (state->ordered) {
+                    state->slots[sequence % state->window] = std::move(r);
+                } else {
+                    state->done.push_back(std::move(r));
+                }
+            }
+            drain(state);
+        }
+
+        template<class Value>
+        void on_next(Value&& v) const {
+            auto localState = state;
+            std::size_t sequence;
+            {
+                std::unique_lock<std::mutex> guard(localState->lock);
+                localState->space.wait(guard, [&](){
+                    return localState->stopped || localState->dispatched - localState->emitted < localState->window;
+                });
+                if (localState->stopped) {
+                    return;
+                }
+                sequence = localState->dispatched++;
+            }
+
+            auto index = sequence % localState->window;
+            auto work = [localState, sequence, v](const rxsc::schedulable&){
+                result_slot r;
+                r.value = on_exception(
+                    [&](){ return localState->selector(v); },
+                    [&](rxu::error_ptr e){
+                        r.failed = true;
+                        r.error = e;
+                    });
+                complete(localState, sequence, std::move(r));
+            };
+            auto selectedWork = on_exception(
+                [&](){ return localState->coordinators[index].act(work); },
+                [&](rxu::error_ptr e){
+                    result_slot r;
+                    r.failed = true;
+                    r.error = e;
+                    complete(localState, sequence, std::move(r));
+                });
+            if (selectedWork.empty()) {
+                return;
+            }
+            localState->workers[index].schedule(selectedWork.get());
+        }
+        void on_error(rxu::error_ptr e) const {
+            {
+                std::unique_lock<std::mutex> guard(state->lock);
+                state->source_error.failed = true;
+                state->source_error.error = e;
+            }
+            drain(state);
+        }
+        void on_completed() const {
+            {
+                std::unique_lock<std::mutex> guard(state->lock);
+                state->completed = true;
+            }
+            drain(state);
+        }
+
+        static subscriber<source_value_type, observer_type> make(dest_type d, map_parallel_values v) {
+            auto cs = composite_subscription();
+            return make_subscriber<source_value_type>(cs, observer_type(this_type(cs, std::move(d), std::move(v))));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(map_parallel_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      map_parallel_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+}
+
+/*! @copydoc rx-map_parallel.hpp
+*/
+template<class... AN>
+auto map_parallel(AN&&... an)
+    ->      operator_factory<map_parallel_tag, AN...> {
+     return operator_factory<map_parallel_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<map_parallel_tag>
+{
+    template<class Observable, class Selector, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class MapParallel = rxo::detail::map_parallel<SourceValue, rxu::decay_t<Selector>, rxu::decay_t<Coordination>>,
+        class Value = typename MapParallel::value_type>
+    static auto member(Observable&& o, Selector&& s, Coordination&& cn)
+        -> decltype(o.template lift<Value>(MapParallel(std::forward<Selector>(s), std::forward<Coordination>(cn), 1, true))) {
+        return      o.template lift<Value>(MapParallel(std::forward<Selector>(s), std::forward<Coordination>(cn), rxo::detail::map_parallel_default_window(), true));
+    }
+
+    template<class Observable, class Selector, class Coordination, class Count,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_coordination<Coordination>,
+            std::is_integral<rxu::decay_t<Count>>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class MapParallel = rxo::detail::map_parallel<SourceValue, rxu::decay_t<Selector>, rxu::decay_t<Coordination>>,
+        class Value = typename MapParallel::value_type>
+    static auto member(Observable&& o, Selector&& s, Coordination&& cn, Count&& c)
+        -> decltype(o.template lift<Value>(MapParallel(std::forward<Selector>(s), std::forward<Coordination>(cn), static_cast<std::size_t>(c), true))) {
+        return      o.template lift<Value>(MapParallel(std::forward<Selector>(s), std::forward<Coordination>(cn), static_cast<std::size_t>(c), true));
+    }
+
+    template<class Observable, class Selector, class Coordination, class Count,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_coordination<Coordination>,
+            std::is_integral<rxu::decay_t<Count>>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class MapParallel = rxo::detail::map_parallel<SourceValue, rxu::decay_t<Selector>, rxu::decay_t<Coordination>>,
+        class Value = typename MapParallel::value_type>
+    static auto member(Observable&& o, Selector&& s, Coordination&& cn, Count&& c, bool ordered)
+        -> decltype(o.template lift<Value>(MapParallel(std::forward<Selector>(s), std::forward<Coordination>(cn), static_cast<std::size_t>(c), ordered))) {
+        return      o.template lift<Value>(MapParallel(std::forward<Selector>(s), std::forward<Coordination>(cn), static_cast<std::size_t>(c), ordered));
+    }
+
+    template<class... AN>
+    static operators::detail::map_parallel_invalid_t<AN...> member(const AN&...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "map_parallel takes (Selector, Coordination, optional MaxInFlight, optional Ordered)");
+    }
+};
+
+}
+
+#endif
@@ -23,6 +23,11 @@
 
     If scheduler is omitted, identity_current_thread is used.
 
+    merge(max_concurrent) subscribes to at most max_concurrent of the nested observables at once, the
+    rest wait in a queue until one completes. The items are emitted without a lock: the thread that finds
+    the emitter idle emits its item in place, other threads queue their item and the emitting thread
+    drains the queue before it leaves. The output is already serialized so no Coordination is taken.
+
     \sample
     \snippet merge.cpp threaded implicit merge sample
     \snippet output.txt threaded implicit merge sample
@@ -125,7 +130,7 @@ struct merge
         auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
 
         // take a copy of the values for each subscription
-        auto state = std::make_shared<merge_state_type>(initial, std::move(coordinator), std::move(scbr));
+        auto state = rxu::make_arena_shared<merge_state_type>(initial, std::move(coordinator), std::move(scbr));
 
         composite_subscription outercs;
 
@@ -208,6 +213,321 @@ struct merge
     }
 };
 
+// a multi producer, single consumer queue. push is lock-free, pop must only be
+// called by one thread at a time.
+template<class T>
+class merge_queue
+{
+    struct node
+    {
+        std::atomic<node*> next;
+        rxu::maybe<T> value;
+    };
+    std::atomic<node*> head;
+    node* tail;
+
+    merge_queue(const merge_queue&);
+    merge_queue& operator=(const merge_queue&);
+public:
+    merge_queue()
+        : head(new node())
+        , tail(head.load())
+    {
+        tail->next = nullptr;
+    }
+    ~merge_queue() {
+        while (tail) {
+            auto next = tail->next.load();
+            delete tail;
+            tail = next;
+        }
+    }
+    void push(T v) {
+        auto n = new node();
+        n->next.store(nullptr, std::memory_order_relaxed);
+        n->value.reset(std::move(v));
+        auto prev = head.exchange(n, std::memory_order_acq_rel);
+        prev->next.store(n, std::memory_order_release);
+    }
+    bool pop(rxu::maybe<T>& v) {
+        auto next = tail->next.load(std::memory_order_acquire);
+        if (!next) {
+            return false;
+        }
+        v.reset(std::move(next->value.get()));
+        next->value.reset();
+        delete tail;
+        tail = next;
+        return true;
+    }
+};
+
+template<class T, class Observable>
+struct merge_max_concurrent
+    : public operator_base<rxu::value_type_t<rxu::decay_t<T>>>
+{
+    typedef merge_max_concurrent<T, Observable> this_type;
+
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Observable> source_type;
+
+    typedef typename source_value_type::value_type value_type;
+
+    struct values
+    {
+        values(source_type o, std::size_t m)
+            : source(std::move(o))
+            , maxConcurrent(m)
+        {
+        }
+        source_type source;
+        std::size_t maxConcurrent;
+    };
+    values initial;
+
+    merge_max_concurrent(source_type o, std::size_t maxConcurrent)
+        : initial(std::move(o), maxConcurrent)
+    {
+        if (initial.maxConcurrent == 0) {
+            std::terminate();
+        }
+    }
+
+    template<class Subscriber>
+    struct merge_state_type : public values
+    {
+        merge_state_type(values i, Subscriber oarg)
+            : values(std::move(i))
+            , out(std::move(oarg))
+            , wip(0)
+            , terminated(false)
+            , subscribing(0)
+            , active(0)
+            , outerDone(false)
+            , done(false)
+            , failed(false)
+        {
+        }
+        Subscriber out;
+
+        // the number of emits and signals that the emitting thread still has
+        // to account for. the thread that moves it from 0 owns out.
+        std::atomic<int> wip;
+        merge_queue<value_type> queue;
+        // only touched by the thread that owns out
+        bool terminated;
+
+        // the same scheme moves the subscribes to the nested observables out
+        // of the stack of the one that completed.
+        std::atomic<int> subscribing;
+        std::mutex lock;
+        std::deque<source_value_type> pending;
+        std::size_t active;
+        bool outerDone;
+
+        std::atomic<bool> done;
+        std::atomic<bool> failed;
+        rxu::error_ptr error;
+    };
+
+    template<class State>
+    static void drain(const State& state) {
+        int missed = 1;
+        for (;;) {
+            rxu::maybe<value_type> v;
+            while (!state->terminated) {
+                if (state->failed) {
+                    state->terminated = true;
+                    state->out.on_error(state->error);
+                    break;
+                }
+                if (!state->queue.pop(v)) {
+                    if (state->done) {
+                        state->terminated = true;
+                        state->out.on_completed();
+                    }
+                    break;
+                }
+                state->out.on_next(std::move(v.get()));
+            }
+            if (state->terminated) {
+                while (state->queue.pop(v)) {
+                }
+            }
+            missed = state->wip.fetch_sub(missed) - missed;
+            if (missed == 0) {
+                return;
+            }
+        }
+    }
+
+    template<class State>
+    static void signal(const State& state) {
+        if (state->wip++ == 0) {
+            drain(state);
+        }
+    }
+
+    template<class State>
+    static void emit(const State& state, value_type v) {
+        int idle = 0;
+        if (state->wip.compare_exchange_strong(idle, 1)) {
+            if (!state->terminated) {
+                state->out.on_next(std::move(v));
+            }
+            if (--state->wip == 0) {
+                return;
+            }
+        } else {
+            state->queue.push(std::move(v));
+            if (state->wip++ != 0) {
+                return;
+            }
+        }
+        drain(state);
+    }
+
+    template<class State>
+    static void fail(const State& state, rxu::error_ptr e) {
+        {
+            std::unique_lock<std::mutex> guard(state->lock);
+            if (state->failed || state->done) {
+                return;
+            }
+            state->error = e;
+            state->failed = true;
+        }
+        signal(state);
+    }
+
+    // called with the lock held
+    template<class State>
+    static bool check_done(const State& state) {
+        if (state->outerDone && state->active == 0 && state->pending.empty() && !state->failed) {
+            state->done = true;
+            return true;
+        }
+        return false;
+    }
+
+    template<class State>
+    static void subscribe_pending(const State& state) {
+        if (state->subscribing++ != 0) {
+            return;
+        }
+        int missed = 1;
+        for (;;) {
+            for (;;) {
+                std::unique_lock<std::mutex> guard(state->lock);
+                if (state->pending.empty() || state->active >= state->maxConcurrent) {
+                    break;
+                }
+                auto next = std::move(state->pending.front());
+                state->pending.pop_front();
+                ++state->active;
+                guard.unlock();
+                subscribe_inner(state, std::move(next));
+            }
+            missed = state->subscribing.fetch_sub(missed) - missed;
+            if (missed == 0) {
+                return;
+            }
+        }
+    }
+
+    template<class State>
+    static void subscribe_inner(const State& state, source_value_type st) {
+        composite_subscription innercs;
+
+        // when the out observer is unsubscribed all the
+        // inner subscriptions are unsubscribed as well
+        auto innercstoken = state->out.add(innercs);
+
+        innercs.add(make_subscription([state, innercstoken](){
+            state->out.remove(innercstoken);
+        }));
+
+        // this subscribe does not share the source subscription
+        // so that when it is unsubscribed the source will continue
+        auto sinkInner = make_subscriber<value_type>(
+            state->out,
+            innercs,
+        // on_next
+            [state](value_type ct) {
+                this_type::emit(state, std::move(ct));
+            },
+        // on_error
+            [state](rxu::error_ptr e) {
+                this_type::fail(state, e);
+            },
+        //on_completed
+            [state](){
+                bool complete = false;
+                {
+                    std::unique_lock<std::mutex> guard(state->lock);
+                    --state->active;
+                    complete = this_type::check_done(state);
+                }
+                if (complete) {
+                    this_type::signal(state);
+                } else {
+                    this_type::subscribe_pending(state);
+                }
+            }
+        );
+        st.subscribe(std::move(sinkInner));
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber scbr) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        typedef merge_state_type<Subscriber> state_type;
+
+        // take a copy of the values for each subscription
+        auto state = rxu::make_arena_shared<state_type>(initial, std::move(scbr));
+
+        composite_subscription outercs;
+
+        // when the out observer is unsubscribed all the
+        // inner subscriptions are unsubscribed as well
+        state->out.add(outercs);
+
+        // this subscribe does not share the observer subscription
+        // so that when it is unsubscribed the observer can be called
+        // until the inner subscriptions have finished
+        auto sink = make_subscriber<source_value_type>(
+            state->out,
+            outercs,
+        // on_next
+            [state](source_value_type st) {
+                {
+                    std::unique_lock<std::mutex> guard(state->lock);
+                    state->pending.push_back(std::move(st));
+                }
+                this_type::subscribe_pending(state);
+            },
+        // on_error
+            [state](rxu::error_ptr e) {
+                this_type::fail(state, e);
+            },
+        // on_completed
+            [state]() {
+                bool complete = false;
+                {
+                    std::unique_lock<std::mutex> guard(state->lock);
+                    state->outerDone = true;
+                    complete = this_type::check_done(state);
+                }
+                if (complete) {
+                    this_type::signal(state);
+                }
+            }
+        );
+        state->source.subscribe(std::move(sink));
+    }
+};
+
 }
 
 /*! @copydoc rx-merge.hpp
@@ -248,6 +568,20 @@ struct member_overload<merge_tag>
         return Result(Merge(std::forward<Observable>(o), std::forward<Coordination>(cn)));
     }
 
+    template<class Observable, class Count,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            std::is_integral<rxu::decay_t<Count>>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class Merge = rxo::detail::merge_max_concurrent<SourceValue, rxu::decay_t<Observable>>,
+        class Value = rxu::value_type_t<SourceValue>,
+        class Result = observable<Value, Merge>,
+        class MaxConcurrent = rxu::decay_t<Count>
+    >
+    static Result member(Observable&& o, Count&& c) {
+        return Result(Merge(std::forward<Observable>(o), static_cast<std::size_t>(c)));
+    }
+
     template<class Observable, class Value0, class... ValueN,
         class Enabled = rxu::enable_if_all_true_type_t<
             all_observables<Observable, Value0, ValueN...>>,
@@ -281,7 +615,7 @@ struct member_overload<merge_tag>
     static operators::detail::merge_invalid_t<AN...> member(AN...) {
         std::terminate();
         return {};
-        static_assert(sizeof...(AN) == 10000, "merge takes (optional Coordination, optional Value0, optional ValueN...)");
+        static_assert(sizeof...(AN) == 10000, "merge takes (optional Coordination, optional Value0, optional ValueN...) or (MaxConcurrent)");
     }
 };
 
@@ -119,7 +119,7 @@ struct merge_delay_error
                 auto coordinator = initial.coordination.create_coordinator(scbr.get_subscription());
 
                 // take a copy of the values for each subscription
-                auto state = std::make_shared<merge_state_type>(initial, std::move(coordinator), std::move(scbr));
+                auto state = rxu::make_arena_shared<merge_state_type>(initial, std::move(coordinator), std::move(scbr));
 
                 composite_subscription outercs;
 
@@ -170,7 +170,7 @@ struct merge_delay_error
                                         [state](rxu::error_ptr e) {
                                                 if(--state->pendingCompletions == 0) {
                                                     state->out.on_error(
-                                                        rxu::make_error_ptr(std::move(state->exception.add(e))));
+                                                        rxu::make_rich_error_ptr(std::move(state->exception.add(e))));
                                                 } else {
                                                         state->exception.add(e);
                                                 }
@@ -180,7 +180,7 @@ struct merge_delay_error
                                                 if (--state->pendingCompletions == 0) {
                                                         if(!state->exception.empty()) {
                                                             state->out.on_error(
-                                                                rxu::make_error_ptr(std::move(state->exception)));
+                                                                rxu::make_rich_error_ptr(std::move(state->exception)));
                                                         } else {
                                                                 state->out.on_completed();
                                                         }
@@ -195,7 +195,7 @@ struct merge_delay_error
                         [state](rxu::error_ptr e) {
                             if(--state->pendingCompletions == 0) {
                                 state->out.on_error(
-                                    rxu::make_error_ptr(std::move(state->exception.add(e))));
+                                    rxu::make_rich_error_ptr(std::move(state->exception.add(e))));
                             } else {
                                 state->exception.add(e);
                             }
@@ -205,7 +205,7 @@ struct merge_delay_error
                             if (--state->pendingCompletions == 0) {
                                 if(!state->exception.empty()) {
                                     state->out.on_error(
-                                        rxu::make_error_ptr(std::move(state->exception)));
+                                        rxu::make_rich_error_ptr(std::move(state->exception)));
                                 } else {
                                     state->out.on_completed();
                                 }
@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-multi_click.hpp
+
+    \brief  For a source of pressed states, emit the position of each press in a run of presses that are no more than period apart.
+
+    \tparam Duration      the type of the time interval
+    \tparam Coordination  the type of the scheduler (optional)
+
+    \param period        the longest time between two presses of the same run
+    \param count         the length of a full run, eg. 2 for double clicks
+    \param coordination  the scheduler whose clock timestamps the presses (optional)
+
+    \return  Observable that emits 1 for the first press of a run, 2 for the second and so on up to count.
+             The press after a full run starts a new run.
+
+    \note The source may repeat the same state, eg. when it is sampled every frame. Only a change
+          from released to pressed counts as a press. Nothing is scheduled and nothing is allocated
+          per press.
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_MULTI_CLICK_HPP)
+#define RXCPP_OPERATORS_RX_MULTI_CLICK_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct multi_click_invalid_arguments {};
+
+template<class... AN>
+struct multi_click_invalid : public rxo::operator_base<multi_click_invalid_arguments<AN...>> {
+    using type = observable<multi_click_invalid_arguments<AN...>, multi_click_invalid<AN...>>;
+};
+template<class... AN>
+using multi_click_invalid_t = typename multi_click_invalid<AN...>::type;
+
+template<class T, class Duration, class Coordination>
+struct multi_click
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef rxu::decay_t<Duration> duration_type;
+
+    duration_type period;
+    std::size_t count;
+    coordination_type coordination;
+
+    multi_click(duration_type p, std::size_t c, coordination_type cn)
+        : period(p)
+        , count(c)
+        , coordination(std::move(cn))
+    {
+        if (count == 0) {
+            std::terminate();
+        }
+    }
+
+    template<class Subscriber>
+    struct multi_click_observer
+    {
+        typedef multi_click_observer<Subscriber> this_type;
+        typedef source_value_type value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<value_type, this_type> observer_type;
+        typedef rxsc::scheduler::clock_type::time_point time_point_type;
+
+        dest_type dest;
+        duration_type period;
+        std::size_t count;
+        coordination_type coordination;
+        mutable time_point_type last_press;
+        mutable std::size_t clicks;
+        mutable bool pressed;
+
+        multi_click_observer(dest_type d, duration_type p, std::size_t c, coordination_type cn)
+            : dest(std::move(d))
+            , period(p)
+            , count(c)
+            , coordination(std::move(cn))
+            , clicks(0)
+            , pressed(false)
+        {
+        }
+        void on_next(const value_type& v) const {
+            bool down = !!v;
+            if (down == pressed) {
+                return;
+            }
+            pressed = down;
+            if (!down) {
+                return;
+            }
+            auto now = coordination.now();
+            if (clicks == count || (clicks != 0 && now - last_press > period)) {
+                clicks = 0;
+            }
+            last_press = now;
+            dest.on_next(++clicks);
+        }
+        void on_error(rxu::error_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            dest.on_completed();
+        }
+
+        static subscriber<value_type, observer_type> make(dest_type d, duration_type p, std::size_t c, coordination_type cn) {
+            return make_subscriber<value_type>(d, this_type(d, p, c, std::move(cn)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(multi_click_observer<Subscriber>::make(std::move(dest), period, count, coordination)) {
+        return      multi_click_observer<Subscriber>::make(std::move(dest), period, count, coordination);
+    }
+};
+
+}
+
+/*! @copydoc rx-multi_click.hpp
+*/
+template<class... AN>
+auto multi_click(AN&&... an)
+    ->      operator_factory<multi_click_tag, AN...> {
+     return operator_factory<multi_click_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<multi_click_tag>
+{
+    template<class Observable, class Duration, class Count,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            rxu::is_duration<Duration>,
+            std::is_integral<rxu::decay_t<Count>>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class MultiClick = rxo::detail::multi_click<SourceValue, rxu::decay_t<Duration>, identity_one_worker>>
+    static auto member(Observable&& o, Duration&& d, Count&& c)
+        -> decltype(o.template lift<std::size_t>(MultiClick(std::forward<Duration>(d), static_cast<std::size_t>(c), identity_current_thread()))) {
+        return      o.template lift<std::size_t>(MultiClick(std::forward<Duration>(d), static_cast<std::size_t>(c), identity_current_thread()));
+    }
+
+    template<class Observable, class Duration, class Count, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            rxu::is_duration<Duration>,
+            std::is_integral<rxu::decay_t<Count>>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class MultiClick = rxo::detail::multi_click<SourceValue, rxu::decay_t<Duration>, rxu::decay_t<Coordination>>>
+    static auto member(Observable&& o, Duration&& d, Count&& c, Coordination&& cn)
+        -> decltype(o.template lift<std::size_t>(MultiClick(std::forward<Duration>(d), static_cast<std::size_t>(c), std::forward<Coordination>(cn)))) {
+        return      o.template lift<std::size_t>(MultiClick(std::forward<Duration>(d), static_cast<std::size_t>(c), std::forward<Coordination>(cn)));
+    }
+
+    template<class... AN>
+    static operators::detail::multi_click_invalid_t<AN...> member(const AN&...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "multi_click takes (required Duration, required Count, optional Coordination)");
+    }
+};
+
+}
+
+#endif
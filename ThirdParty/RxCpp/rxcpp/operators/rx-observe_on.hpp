@@ -8,10 +8,17 @@
 
     \tparam Coordination  the type of the scheduler.
 
-    \param  cn  the scheduler to notify observers on.
+    \param  cn        the scheduler to notify observers on.
+    \param  capacity  the most items that may wait in the queue (optional, the queue is unbounded without it).
+    \param  policy    what to do with an item that arrives when the queue is full (required with capacity).
+    \param  counters  receives the queue depth, its high water mark and the number of dropped items (optional).
 
     \return  The source observable modified so that its observers are notified on the specified scheduler.
 
+    \note With overflow_policy::block the source waits for the consumer, so it must not run on the
+          thread of the coordination. A bounded queue hands the items to the consumer one at a time
+          under the lock instead of swapping the whole queue, so that a full queue can be trimmed.
+
     \sample
     \snippet observe_on.cpp observe_on sample
     \snippet output.txt observe_on sample
@@ -27,6 +34,43 @@
 
 namespace rxcpp {
 
+/// what a bounded observe_on does with an item that arrives when its queue is full.
+enum class overflow_policy
+{
+    /// wait until the consumer makes room
+    block,
+    /// drop the item that arrived
+    drop_newest,
+    /// drop the item at the front of the queue
+    drop_oldest,
+    /// replace the item at the back of the queue
+    keep_latest,
+    /// drop the queued items, emit queue_overflow_error and unsubscribe from the source
+    error
+};
+
+class queue_overflow_error: public std::runtime_error
+{
+    public:
+        explicit queue_overflow_error(const std::string& msg):
+            std::runtime_error(msg)
+        {}
+};
+
+/// shared with a bounded observe_on to watch its queue.
+struct queue_counters
+{
+    queue_counters()
+        : depth(0)
+        , high_water(0)
+        , dropped(0)
+    {
+    }
+    std::atomic<std::size_t> depth;
+    std::atomic<std::size_t> high_water;
+    std::atomic<std::size_t> dropped;
+};
+
 namespace operators {
 
 namespace detail {
@@ -41,6 +85,28 @@ struct observe_on_invalid : public rxo::operator_base<observe_on_invalid_argumen
 template<class... AN>
 using observe_on_invalid_t = typename observe_on_invalid<AN...>::type;
 
+struct observe_on_bound
+{
+    observe_on_bound()
+        : capacity(0)
+        , policy(overflow_policy::block)
+    {
+    }
+    observe_on_bound(std::size_t c, overflow_policy p, std::shared_ptr<queue_counters> qc)
+        : capacity(c)
+        , policy(p)
+        , counters(std::move(qc))
+    {
+        if (capacity == 0) {
+            std::terminate();
+        }
+    }
+    // 0 is unbounded
+    std::size_t capacity;
+    overflow_policy policy;
+    std::shared_ptr<queue_counters> counters;
+};
+
 template<class T, class Coordination>
 struct observe_on
 {
@@ -50,9 +116,11 @@ struct observe_on
     typedef typename coordination_type::coordinator_type coordinator_type;
 
     coordination_type coordination;
+    observe_on_bound bound;
 
-    observe_on(coordination_type cn)
+    observe_on(coordination_type cn, observe_on_bound b = observe_on_bound())
         : coordination(std::move(cn))
+        , bound(std::move(b))
     {
     }
 
@@ -81,27 +149,83 @@ struct observe_on
         struct observe_on_state : std::enable_shared_from_this<observe_on_state>
         {
             mutable std::mutex lock;
+            mutable std::condition_variable space;
             mutable queue_type fill_queue;
             mutable queue_type drain_queue;
             composite_subscription lifetime;
             mutable typename mode::type current;
             coordinator_type coordinator;
             dest_type destination;
+            observe_on_bound bound;
+            mutable bool overflowed;
 
-            observe_on_state(dest_type d, coordinator_type coor, composite_subscription cs)
+            observe_on_state(dest_type d, coordinator_type coor, composite_subscription cs, observe_on_bound b)
                 : lifetime(std::move(cs))
                 , current(mode::Empty)
                 , coordinator(std::move(coor))
                 , destination(std::move(d))
+                , bound(std::move(b))
+                , overflowed(false)
             {
             }
 
+            void count_depth() const {
+                if (!bound.counters) {
+                    return;
+                }
+                auto depth = fill_queue.size();
+                bound.counters->depth = depth;
+                if (depth > bound.counters->high_water) {
+                    bound.counters->high_water = depth;
+                }
+            }
+
+            // returns false when the item that arrived must not be queued.
+            bool make_room(std::unique_lock<std::mutex>& guard) const {
+                if (bound.capacity == 0 || fill_queue.size() < bound.capacity) {
+                    return true;
+                }
+                switch (bound.policy) {
+                case overflow_policy::block:
+                    // the drain that would make room may have been dropped
+                    // by the unsubscribe, so the lifetime releases the wait.
+                    space.wait(guard, [this](){
+                        return fill_queue.size() < bound.capacity || current == mode::Errored || current == mode::Disposed || !lifetime.is_subscribed();
+                    });
+                    return current != mode::Errored && current != mode::Disposed && lifetime.is_subscribed();
+                case overflow_policy::drop_oldest:
+                    fill_queue.pop_front();
+                    break;
+                case overflow_policy::keep_latest:
+                    fill_queue.pop_back();
+                    break;
+                case overflow_policy::drop_newest:
+                    if (bound.counters) {
+                        ++bound.counters->dropped;
+                    }
+                    return false;
+                case overflow_policy::error:
+                    overflowed = true;
+                    if (bound.counters) {
+                        bound.counters->dropped += fill_queue.size() + 1;
+                    }
+                    fill_queue.clear();
+                    fill_queue.push_back(notification_type::on_error(rxu::make_static_error_ptr<queue_overflow_error>("observe_on queue is full")));
+                    return false;
+                }
+                if (bound.counters) {
+                    ++bound.counters->dropped;
+                }
+                return true;
+            }
+
             void finish(std::unique_lock<std::mutex>& guard, typename mode::type end) const {
                 if (!guard.owns_lock()) {
                     std::terminate();
                 }
                 if (current == mode::Errored || current == mode::Disposed) {return;}
                 current = end;
+                space.notify_all();
                 queue_type fill_expired;
                 swap(fill_expired, fill_queue);
                 queue_type drain_expired;
@@ -141,7 +265,14 @@ struct observe_on
                                             current = mode::Empty;
                                             return;
                                         }
-                                        swap(fill_queue, drain_queue);
+                                        if (bound.capacity == 0) {
+                                            swap(fill_queue, drain_queue);
+                                        } else {
+                                            drain_queue.push_back(std::move(fill_queue.front()));
+                                            fill_queue.pop_front();
+                                            count_depth();
+                                            space.notify_one();
+                                        }
                                     }
                                 }
                                 auto notification = std::move(drain_queue.front());
@@ -178,39 +309,49 @@ struct observe_on
         };
         std::shared_ptr<observe_on_state> state;
 
-        observe_on_observer(dest_type d, coordinator_type coor, composite_subscription cs)
-            : state(std::make_shared<observe_on_state>(std::move(d), std::move(coor), std::move(cs)))
+        observe_on_observer(dest_type d, coordinator_type coor, composite_subscription cs, observe_on_bound b)
+            : state(std::make_shared<observe_on_state>(std::move(d), std::move(coor), std::move(cs), std::move(b)))
         {
         }
 
         template<typename U>
         void on_next(U&& v) const {
             std::unique_lock<std::mutex> guard(state->lock);
-            if (state->current == mode::Errored || state->current == mode::Disposed) { return; }
+            if (state->current == mode::Errored || state->current == mode::Disposed || state->overflowed) { return; }
+            if (!state->make_room(guard)) {
+                if (state->overflowed) {
+                    state->ensure_processing(guard);
+                    guard.unlock();
+                    state->lifetime.unsubscribe();
+                }
+                return;
+            }
             state->fill_queue.push_back(notification_type::on_next(std::forward<U>(v)));
+            state->count_depth();
             state->ensure_processing(guard);
         }
         void on_error(rxu::error_ptr e) const {
             std::unique_lock<std::mutex> guard(state->lock);
-            if (state->current == mode::Errored || state->current == mode::Disposed) { return; }
+            if (state->current == mode::Errored || state->current == mode::Disposed || state->overflowed) { return; }
             state->fill_queue.push_back(notification_type::on_error(e));
             state->ensure_processing(guard);
         }
         void on_completed() const {
             std::unique_lock<std::mutex> guard(state->lock);
-            if (state->current == mode::Errored || state->current == mode::Disposed) { return; }
+            if (state->current == mode::Errored || state->current == mode::Disposed || state->overflowed) { return; }
             state->fill_queue.push_back(notification_type::on_completed());
             state->ensure_processing(guard);
         }
 
-        static subscriber<value_type, observer<value_type, this_type>> make(dest_type d, coordination_type cn, composite_subscription cs = composite_subscription()) {
+        static subscriber<value_type, observer<value_type, this_type>> make(dest_type d, coordination_type cn, observe_on_bound b = observe_on_bound(), composite_subscription cs = composite_subscription()) {
             auto coor = cn.create_coordinator(d.get_subscription());
             d.add(cs);
 
-            this_type o(d, std::move(coor), cs);
+            this_type o(d, std::move(coor), cs, std::move(b));
             auto keepAlive = o.state;
             cs.add([=](){
                 std::unique_lock<std::mutex> guard(keepAlive->lock);
+                keepAlive->space.notify_all();
                 keepAlive->ensure_processing(guard);
             });
 
@@ -220,8 +361,8 @@ struct observe_on
 
     template<class Subscriber>
     auto operator()(Subscriber dest) const
-        -> decltype(observe_on_observer<decltype(dest.as_dynamic())>::make(dest.as_dynamic(), coordination)) {
-        return      observe_on_observer<decltype(dest.as_dynamic())>::make(dest.as_dynamic(), coordination);
+        -> decltype(observe_on_observer<decltype(dest.as_dynamic())>::make(dest.as_dynamic(), coordination, bound)) {
+        return      observe_on_observer<decltype(dest.as_dynamic())>::make(dest.as_dynamic(), coordination, bound);
     }
 };
 
@@ -251,11 +392,35 @@ struct member_overload<observe_on_tag>
         return      o.template lift<SourceValue>(ObserveOn(std::forward<Coordination>(cn)));
     }
 
+    template<class Observable, class Coordination, class Count,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_coordination<Coordination>,
+            std::is_integral<rxu::decay_t<Count>>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class ObserveOn = rxo::detail::observe_on<SourceValue, rxu::decay_t<Coordination>>>
+    static auto member(Observable&& o, Coordination&& cn, Count&& c, overflow_policy p)
+        -> decltype(o.template lift<SourceValue>(ObserveOn(std::forward<Coordination>(cn), rxo::detail::observe_on_bound(static_cast<std::size_t>(c), p, nullptr)))) {
+        return      o.template lift<SourceValue>(ObserveOn(std::forward<Coordination>(cn), rxo::detail::observe_on_bound(static_cast<std::size_t>(c), p, nullptr)));
+    }
+
+    template<class Observable, class Coordination, class Count,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_coordination<Coordination>,
+            std::is_integral<rxu::decay_t<Count>>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class ObserveOn = rxo::detail::observe_on<SourceValue, rxu::decay_t<Coordination>>>
+    static auto member(Observable&& o, Coordination&& cn, Count&& c, overflow_policy p, std::shared_ptr<queue_counters> qc)
+        -> decltype(o.template lift<SourceValue>(ObserveOn(std::forward<Coordination>(cn), rxo::detail::observe_on_bound(static_cast<std::size_t>(c), p, std::move(qc))))) {
+        return      o.template lift<SourceValue>(ObserveOn(std::forward<Coordination>(cn), rxo::detail::observe_on_bound(static_cast<std::size_t>(c), p, std::move(qc))));
+    }
+
     template<class... AN>
     static operators::detail::observe_on_invalid_t<AN...> member(AN...) {
         std::terminate();
         return {};
-        static_assert(sizeof...(AN) == 10000, "observe_on takes (Coordination)");
+        static_assert(sizeof...(AN) == 10000, "observe_on takes (Coordination, optional Capacity and overflow_policy, optional queue_counters)");
     }
 };
 
@@ -0,0 +1,348 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-partition.hpp
+
+    \brief Return an observable that emits a fixed number of grouped_observables, one for each lane, and deliver each item of the source observable on the lane that its key hashes to.
+
+    \tparam KeySelector   the type of the key extracting function
+    \tparam Coordination  the type of the scheduler that provides the lane workers
+
+    \param  ks            a function that extracts the key for each item, the key must be hashable with std::hash
+    \param  lanes         the number of lanes
+    \param  coordination  the scheduler that provides one worker for each lane, eg. observe_on_event_loop()
+
+    \return  Observable that emits lanes grouped_observables when it is subscribed, the key of each is the index of the lane.
+             Each lane emits the items whose key hashes to it, in source order, on the worker of the lane.
+
+    \note Unlike group_by followed by observe_on, the number of subjects, workers and queues is fixed by lanes and does
+          not grow with the number of distinct keys. Items with the same key always share a lane, so their order is kept.
+          The source appends to the queue of the lane and the worker drains the queue in batches.
+          A lane holds its items until it gets its first subscriber, so a lane may be subscribed later, eg. through
+          observe_on or subscribe_on, without losing items. A lane that is never subscribed keeps its items until the
+          source is unsubscribed. Each lane releases its worker once it has delivered the end of the source, or when
+          every subscriber is gone.
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_PARTITION_HPP)
+#define RXCPP_OPERATORS_RX_PARTITION_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct partition_invalid_arguments {};
+
+template<class... AN>
+struct partition_invalid : public rxo::operator_base<partition_invalid_arguments<AN...>> {
+    using type = observable<partition_invalid_arguments<AN...>, partition_invalid<AN...>>;
+};
+template<class... AN>
+using partition_invalid_t = typename partition_invalid<AN...>::type;
+
+template<class T, class KeySelector, class Coordination>
+struct partition
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<KeySelector> key_selector_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxu::decay_t<decltype((*(key_selector_type*)nullptr)(*(source_value_type*)nullptr))> key_type;
+    typedef rxsub::subject<source_value_type> subject_type;
+    typedef grouped_observable<std::size_t, source_value_type> grouped_observable_type;
+
+    // one serial lane. the source appends to queue and the worker of the lane
+    // swaps it with delivering and emits the batch. the worker is not armed
+    // until the lane is open, which happens when it gets its first subscriber.
+    // the worker is released once the lane has delivered the end of the source.
+    struct lane_type
+    {
+        explicit lane_type(const coordination_type& cn)
+            : coordinator(cn.create_coordinator(lifetime))
+            , worker(coordinator.get_worker())
+            , subscriber(subject.get_subscriber())
+            , open(false)
+            , armed(false)
+            , completed(false)
+            , failed(false)
+        {
+        }
+        ~lane_type()
+        {
+            // a lane that was never subscribed
+            lifetime.unsubscribe();
+        }
+        composite_subscription lifetime;
+        coordinator_type coordinator;
+        rxsc::worker worker;
+        subject_type subject;
+        typename subject_type::subscriber_type subscriber;
+
+        std::mutex lock;
+        std::vector<source_value_type> queue;
+        std::vector<source_value_type> delivering;
+        bool open;
+        bool armed;
+        bool completed;
+        bool failed;
+        rxu::error_ptr error;
+    };
+
+    struct partition_state_type
+    {
+        partition_state_type(composite_subscription sl, const coordination_type& cn, std::size_t count)
+            : source_lifetime(std::move(sl))
+            , observers(0)
+        {
+            for (std::size_t i = 0; i < count; ++i) {
+                lanes.emplace_back(new lane_type(cn));
+            }
+        }
+        composite_subscription source_lifetime;
+        std::vector<std::unique_ptr<lane_type>> lanes;
+        std::atomic<int> observers;
+    };
+    typedef std::shared_ptr<partition_state_type> state_type;
+
+    template<class Subscriber>
+    static void stopsource(Subscriber&& dest, state_type& state) {
+        ++state->observers;
+        dest.add([state](){
+            if (--state->observers != 0) {
+                return;
+            }
+            // once the source has ended, a lane that is not open yet keeps
+            // the end for a late subscriber.
+            bool ended = !state->source_lifetime.is_subscribed();
+            state->source_lifetime.unsubscribe();
+            for (auto& lane : state->lanes) {
+                std::unique_lock<std::mutex> guard(lane->lock);
+                bool keep = ended && !lane->open;
+                guard.unlock();
+                if (!keep) {
+                    lane->lifetime.unsubscribe();
+                }
+            }
+        });
+    }
+
+    static void drain(lane_type& lane) {
+        std::unique_lock<std::mutex> guard(lane.lock);
+        while (!lane.queue.empty()) {
+            std::swap(lane.queue, lane.delivering);
+            guard.unlock();
+            for (auto& v : lane.delivering) {
+                lane.subscriber.on_next(std::move(v));
+            }
+            lane.delivering.clear();
+            guard.lock();
+        }
+        lane.armed = false;
+        if (lane.failed) {
+            auto e = lane.error;
+            guard.unlock();
+            lane.subscriber.on_error(e);
+            lane.lifetime.unsubscribe();
+        } else if (lane.completed) {
+            guard.unlock();
+            lane.subscriber.on_completed();
+            lane.lifetime.unsubscribe();
+        }
+    }
+
+    static void arm(const state_type& state, lane_type& lane, std::unique_lock<std::mutex>& guard) {
+        if (lane.armed || !lane.open) {
+            return;
+        }
+        lane.armed = true;
+        guard.unlock();
+        auto localState = state;
+        auto localLane = &lane;
+        // localState keeps the lane alive until the drain has run
+        auto work = [localState, localLane](const rxsc::schedulable&){
+            drain(*localLane);
+        };
+        auto selectedWork = on_exception(
+            [&](){return lane.coordinator.act(work);},
+            [&](rxu::error_ptr e){lane.subscriber.on_error(e);});
+        if (selectedWork.empty()) {
+            return;
+        }
+        lane.worker.schedule(selectedWork.get());
+    }
+
+    struct partition_values
+    {
+        partition_values(key_selector_type ks, std::size_t l, coordination_type cn)
+            : keySelector(std::move(ks))
+            , lanes(l)
+            , coordination(std::move(cn))
+        {
+        }
+        mutable key_selector_type keySelector;
+        std::size_t lanes;
+        coordination_type coordination;
+    };
+
+    partition_values initial;
+
+    partition(key_selector_type ks, std::size_t lanes, coordination_type cn)
+        : initial(std::move(ks), lanes, std::move(cn))
+    {
+        if (initial.lanes == 0) {
+            std::terminate();
+        }
+    }
+
+    struct partition_observable : public rxs::source_base<source_value_type>
+    {
+        mutable state_type state;
+        std::size_t index;
+
+        partition_observable(state_type st, std::size_t i)
+            : state(std::move(st))
+            , index(i)
+        {
+        }
+
+        template<class Subscriber>
+        void on_subscribe(Subscriber&& o) const {
+            partition::stopsource(o, state);
+            auto& lane = *state->lanes[index];
+            lane.subject.get_observable().subscribe(std::forward<Subscriber>(o));
+            std::unique_lock<std::mutex> guard(lane.lock);
+            if (lane.open) {
+                return;
+            }
+            lane.open = true;
+            if (!lane.queue.empty() || lane.completed || lane.failed) {
+                partition::arm(state, lane, guard);
+            }
+        }
+
+        std::size_t on_get_key() {
+            return index;
+        }
+    };
+
+    template<class Subscriber>
+    struct partition_observer : public partition_values
+    {
+        typedef partition_observer<Subscriber> this_type;
+        typedef grouped_observable_type value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<T, this_type> observer_type;
+
+        dest_type dest;
+
+        mutable state_type state;
+
+        partition_observer(composite_subscription l, dest_type d, partition_values v)
+            : partition_values(v)
+            , dest(std::move(d))
+            , state(rxu::make_arena_shared<partition_state_type>(l, partition_values::coordination, partition_values::lanes))
+        {
+            partition::stopsource(dest, state);
+        }
+
+        void open_lanes() const {
+            for (std::size_t i = 0; i < state->lanes.size(); ++i) {
+                dest.on_next(make_dynamic_grouped_observable<std::size_t, source_value_type>(partition_observable(state, i)));
+            }
+        }
+
+        template<typename U>
+        void on_next(U&& v) const {
+            auto selectedKey = on_exception(
+                [&](){
+                    return this->keySelector(v);},
+                [this](rxu::error_ptr e){on_error(e);});
+            if (selectedKey.empty()) {
+                return;
+            }
+            auto& lane = *state->lanes[std::hash<key_type>()(selectedKey.get()) % state->lanes.size()];
+            std::unique_lock<std::mutex> guard(lane.lock);
+            lane.queue.push_back(std::forward<U>(v));
+            partition::arm(state, lane, guard);
+        }
+        void on_error(rxu::error_ptr e) const {
+            for (auto& lane : state->lanes) {
+                std::unique_lock<std::mutex> guard(lane->lock);
+                lane->failed = true;
+                lane->error = e;
+                partition::arm(state, *lane, guard);
+            }
+            // the lanes outlive dest once the source is done
+            state->source_lifetime.unsubscribe();
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            for (auto& lane : state->lanes) {
+                std::unique_lock<std::mutex> guard(lane->lock);
+                lane->completed = true;
+                partition::arm(state, *lane, guard);
+            }
+            state->source_lifetime.unsubscribe();
+            dest.on_completed();
+        }
+
+        static subscriber<T, observer_type> make(dest_type d, partition_values v) {
+            auto cs = composite_subscription();
+            auto o = this_type(cs, std::move(d), std::move(v));
+            o.open_lanes();
+            return make_subscriber<T>(cs, observer_type(std::move(o)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(partition_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      partition_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+}
+
+/*! @copydoc rx-partition.hpp
+*/
+template<class... AN>
+auto partition(AN&&... an)
+    ->     operator_factory<partition_tag, AN...> {
+    return operator_factory<partition_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<partition_tag>
+{
+    template<class Observable, class KeySelector, class Count, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            std::is_integral<rxu::decay_t<Count>>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class Partition = rxo::detail::partition<SourceValue, rxu::decay_t<KeySelector>, rxu::decay_t<Coordination>>,
+        class Value = typename Partition::grouped_observable_type>
+    static auto member(Observable&& o, KeySelector&& ks, Count&& c, Coordination&& cn)
+        -> decltype(o.template lift<Value>(Partition(std::forward<KeySelector>(ks), static_cast<std::size_t>(c), std::forward<Coordination>(cn)))) {
+        return      o.template lift<Value>(Partition(std::forward<KeySelector>(ks), static_cast<std::size_t>(c), std::forward<Coordination>(cn)));
+    }
+
+    template<class... AN>
+    static operators::detail::partition_invalid_t<AN...> member(const AN&...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "partition takes (KeySelector, Lanes, Coordination), KeySelector takes (Observable::value_type) -> KeyValue");
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,251 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-press_gesture.hpp
+
+    \brief  For a source of pressed states, emit the phases of each press: began, then either tapped or long_pressed and ended.
+
+    \tparam Duration      the type of the time interval
+    \tparam Coordination  the type of the scheduler
+
+    \param period        how long a press must be held to become a long press
+    \param coordination  the scheduler that runs the long press timer
+
+    \return  Observable that emits press_phase::began when the press starts. A release before period has
+             passed emits press_phase::tapped. Otherwise press_phase::long_pressed is emitted when period
+             has passed and press_phase::ended on release.
+
+    \note The source may repeat the same state, eg. when it is sampled every frame. Each press arms
+          one timer. The timer runs on the worker of the coordination, use one that runs on the thread
+          that produces the source, eg. identity_frame_clock. There is no default, a coordination that
+          waits for the timer on the calling thread, eg. identity_current_thread, would hold the press
+          for the whole period and never see the release in time. A drag is the values of another stream
+          between long_pressed and ended.
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_PRESS_GESTURE_HPP)
+#define RXCPP_OPERATORS_RX_PRESS_GESTURE_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+enum class press_phase
+{
+    began,
+    tapped,
+    long_pressed,
+    ended
+};
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct press_gesture_invalid_arguments {};
+
+template<class... AN>
+struct press_gesture_invalid : public rxo::operator_base<press_gesture_invalid_arguments<AN...>> {
+    using type = observable<press_gesture_invalid_arguments<AN...>, press_gesture_invalid<AN...>>;
+};
+template<class... AN>
+using press_gesture_invalid_t = typename press_gesture_invalid<AN...>::type;
+
+template<class T, class Duration, class Coordination>
+struct press_gesture
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxu::decay_t<Duration> duration_type;
+
+    struct press_gesture_values
+    {
+        press_gesture_values(duration_type p, coordination_type c)
+            : period(p)
+            , coordination(c)
+        {
+        }
+
+        duration_type period;
+        coordination_type coordination;
+    };
+    press_gesture_values initial;
+
+    press_gesture(duration_type period, coordination_type coordination)
+        : initial(period, coordination)
+    {
+    }
+
+    template<class Subscriber>
+    struct press_gesture_observer
+    {
+        typedef press_gesture_observer<Subscriber> this_type;
+        typedef source_value_type value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<value_type, this_type> observer_type;
+
+        enum class press_state
+        {
+            released,
+            pressed,
+            long_pressed
+        };
+
+        struct press_gesture_subscriber_values : public press_gesture_values
+        {
+            press_gesture_subscriber_values(composite_subscription cs, dest_type d, press_gesture_values v, coordinator_type c)
+                : press_gesture_values(v)
+                , cs(std::move(cs))
+                , dest(std::move(d))
+                , coordinator(std::move(c))
+                , worker(coordinator.get_worker())
+                , current(press_state::released)
+            {
+            }
+
+            composite_subscription cs;
+            dest_type dest;
+            coordinator_type coordinator;
+            rxsc::worker worker;
+            // the timer and the source can run on different threads
+            mutable std::mutex lock;
+            mutable press_state current;
+            // a timer left over from an earlier press fires before this and does nothing
+            mutable rxsc::scheduler::clock_type::time_point long_press_at;
+        };
+        typedef std::shared_ptr<press_gesture_subscriber_values> state_type;
+        state_type state;
+        // built once, every press schedules the same action
+        rxsc::schedulable timer;
+        bool timed;
+
+        press_gesture_observer(composite_subscription cs, dest_type d, press_gesture_values v, coordinator_type c)
+            : state(std::make_shared<press_gesture_subscriber_values>(std::move(cs), std::move(d), v, std::move(c)))
+            , timed(false)
+        {
+            auto localState = state;
+
+            auto disposer = [=](const rxsc::schedulable&){
+                localState->cs.unsubscribe();
+                localState->dest.unsubscribe();
+                localState->worker.unsubscribe();
+            };
+            auto selectedDisposer = on_exception(
+                [&](){ return localState->coordinator.act(disposer); },
+                localState->dest);
+            if (selectedDisposer.empty()) {
+                return;
+            }
+
+            localState->dest.add([=](){
+                localState->worker.schedule(selectedDisposer.get());
+            });
+            localState->cs.add([=](){
+                localState->worker.schedule(selectedDisposer.get());
+            });
+
+            auto expire = [localState](const rxsc::schedulable&){
+                std::unique_lock<std::mutex> guard(localState->lock);
+                if (localState->current != press_state::pressed || localState->worker.now() < localState->long_press_at) {
+                    return;
+                }
+                localState->current = press_state::long_pressed;
+                localState->dest.on_next(press_phase::long_pressed);
+            };
+            auto selectedExpire = on_exception(
+                [&](){ return localState->coordinator.act(expire); },
+                localState->dest);
+            if (selectedExpire.empty()) {
+                return;
+            }
+            timer = rxsc::make_schedulable(localState->worker, selectedExpire.get());
+            timed = true;
+        }
+
+        // the phases are emitted under the lock so that they stay in order,
+        // the timer is scheduled after it is released in case it runs inline.
+        void on_next(const value_type& v) const {
+            bool down = !!v;
+            std::unique_lock<std::mutex> guard(state->lock);
+            if (down == (state->current != press_state::released)) {
+                return;
+            }
+            if (down) {
+                state->current = press_state::pressed;
+                auto due = state->long_press_at = state->worker.now() + state->period;
+                state->dest.on_next(press_phase::began);
+                guard.unlock();
+                if (timed) {
+                    state->worker.schedule(due, timer);
+                }
+                return;
+            }
+            auto previous = state->current;
+            state->current = press_state::released;
+            state->dest.on_next(previous == press_state::long_pressed ? press_phase::ended : press_phase::tapped);
+        }
+        void on_error(rxu::error_ptr e) const {
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->dest.on_error(e);
+        }
+        void on_completed() const {
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->dest.on_completed();
+        }
+
+        static subscriber<value_type, observer_type> make(dest_type d, press_gesture_values v) {
+            auto cs = composite_subscription();
+            auto coordinator = v.coordination.create_coordinator();
+
+            return make_subscriber<value_type>(cs, observer_type(this_type(cs, std::move(d), std::move(v), std::move(coordinator))));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(press_gesture_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      press_gesture_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+}
+
+/*! @copydoc rx-press_gesture.hpp
+*/
+template<class... AN>
+auto press_gesture(AN&&... an)
+    ->      operator_factory<press_gesture_tag, AN...> {
+     return operator_factory<press_gesture_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<press_gesture_tag>
+{
+    template<class Observable, class Duration, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            rxu::is_duration<Duration>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class PressGesture = rxo::detail::press_gesture<SourceValue, rxu::decay_t<Duration>, rxu::decay_t<Coordination>>>
+    static auto member(Observable&& o, Duration&& d, Coordination&& cn)
+        -> decltype(o.template lift<press_phase>(PressGesture(std::forward<Duration>(d), std::forward<Coordination>(cn)))) {
+        return      o.template lift<press_phase>(PressGesture(std::forward<Duration>(d), std::forward<Coordination>(cn)));
+    }
+
+    template<class... AN>
+    static operators::detail::press_gesture_invalid_t<AN...> member(const AN&...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "press_gesture takes (required Duration, required Coordination)");
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-record_to.hpp
+
+    \brief Record each value in a flight_recorder and then pass it on unchanged.
+
+    \tparam Coordination  the type of the scheduler (optional)
+
+    \param recorder      the shared flight_recorder to append to
+    \param stream        the id that tags the records of this stream
+    \param coordination  the scheduler whose clock timestamps each record (optional)
+
+    \return  Observable that emits the same items as the source observable.
+
+    \note The value type must be trivially copyable and fit in the payload size of the recorder, both are checked at compile time.
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_RECORD_TO_HPP)
+#define RXCPP_OPERATORS_RX_RECORD_TO_HPP
+
+#include "../rx-includes.hpp"
+#include "../rx-recorder.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct record_to_invalid_arguments {};
+
+template<class... AN>
+struct record_to_invalid : public rxo::operator_base<record_to_invalid_arguments<AN...>> {
+    using type = observable<record_to_invalid_arguments<AN...>, record_to_invalid<AN...>>;
+};
+template<class... AN>
+using record_to_invalid_t = typename record_to_invalid<AN...>::type;
+
+template<class T, class Coordination, class Recorder>
+struct record_to
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef std::shared_ptr<Recorder> recorder_type;
+
+    static_assert(std::is_trivially_copyable<source_value_type>::value, "record_to can only record trivially copyable values");
+    static_assert(sizeof(source_value_type) <= Recorder::payload_capacity, "record_to value does not fit the payload size of the flight_recorder");
+
+    recorder_type recorder;
+    std::uint32_t stream;
+    coordination_type coordination;
+
+    record_to(recorder_type r, std::uint32_t s, coordination_type cn)
+        : recorder(std::move(r))
+        , stream(s)
+        , coordination(std::move(cn))
+    {
+        if (!recorder) {
+            std::terminate();
+        }
+    }
+
+    template<class Subscriber>
+    struct record_to_observer
+    {
+        typedef record_to_observer<Subscriber> this_type;
+        typedef source_value_type value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<value_type, this_type> observer_type;
+        dest_type dest;
+        recorder_type recorder;
+        std::uint32_t stream;
+        coordination_type coordination;
+
+        record_to_observer(dest_type d, recorder_type r, std::uint32_t s, coordination_type cn)
+            : dest(std::move(d))
+            , recorder(std::move(r))
+            , stream(s)
+            , coordination(std::move(cn))
+        {
+        }
+        template<typename U>
+        void on_next(U&& v) const {
+            recorder->record(stream, coordination.now(), static_cast<const value_type&>(v));
+            dest.on_next(std::forward<U>(v));
+        }
+        void on_error(rxu::error_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            dest.on_completed();
+        }
+
+        static subscriber<value_type, observer_type> make(dest_type d, recorder_type r, std::uint32_t s, coordination_type cn) {
+            return make_subscriber<value_type>(d, this_type(d, std::move(r), s, std::move(cn)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(record_to_observer<Subscriber>::make(std::move(dest), recorder, stream, coordination)) {
+        return      record_to_observer<Subscriber>::make(std::move(dest), recorder, stream, coordination);
+    }
+};
+
+}
+
+/*! @copydoc rx-record_to.hpp
+*/
+template<class... AN>
+auto record_to(AN&&... an)
+    ->      operator_factory<record_to_tag, AN...> {
+     return operator_factory<record_to_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<record_to_tag>
+{
+    template<class Observable, std::uint32_t PayloadSize, class Stream,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            std::is_integral<rxu::decay_t<Stream>>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class RecordTo = rxo::detail::record_to<SourceValue, identity_one_worker, recorder::basic_flight_recorder<PayloadSize>>>
+    static auto member(Observable&& o, std::shared_ptr<recorder::basic_flight_recorder<PayloadSize>> r, Stream&& s)
+        -> decltype(o.template lift<SourceValue>(RecordTo(std::move(r), static_cast<std::uint32_t>(s), identity_current_thread()))) {
+        return      o.template lift<SourceValue>(RecordTo(std::move(r), static_cast<std::uint32_t>(s), identity_current_thread()));
+    }
+
+    template<class Observable, std::uint32_t PayloadSize, class Stream, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            std::is_integral<rxu::decay_t<Stream>>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class RecordTo = rxo::detail::record_to<SourceValue, rxu::decay_t<Coordination>, recorder::basic_flight_recorder<PayloadSize>>>
+    static auto member(Observable&& o, std::shared_ptr<recorder::basic_flight_recorder<PayloadSize>> r, Stream&& s, Coordination&& cn)
+        -> decltype(o.template lift<SourceValue>(RecordTo(std::move(r), static_cast<std::uint32_t>(s), std::forward<Coordination>(cn)))) {
+        return      o.template lift<SourceValue>(RecordTo(std::move(r), static_cast<std::uint32_t>(s), std::forward<Coordination>(cn)));
+    }
+
+    template<class... AN>
+    static operators::detail::record_to_invalid_t<AN...> member(const AN&...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "record_to takes (shared_ptr<basic_flight_recorder>, stream id, optional Coordination)");
+    }
+};
+
+}
+
+#endif
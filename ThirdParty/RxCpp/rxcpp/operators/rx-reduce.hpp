@@ -157,7 +157,7 @@ struct reduce : public operator_base<rxu::value_type_t<reduce_traits<T, Observab
         private:
             reduce_state_type& operator=(reduce_state_type o) RXCPP_DELETE;
         };
-        auto state = std::make_shared<reduce_state_type>(initial, std::move(o));
+        auto state = rxu::make_arena_shared<reduce_state_type>(initial, std::move(o));
         state->source.subscribe(
             state->out,
         // on_next
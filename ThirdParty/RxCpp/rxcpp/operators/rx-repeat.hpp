@@ -9,6 +9,7 @@
     \tparam Count  the type of the counter (optional).
 
     \param t The number of times the source observable items are repeated (optional). If not specified, infinitely repeats the source observable. Specifying 0 returns an empty sequence immediately
+    \param r rxcpp::reuse_arena() (optional). Allocates the subscriptions and operator states of each repetition in memory reused from an earlier repetition, see rx-arena.hpp.
 
     \return  An observable that repeats the sequence of items emitted by the source observable for t times.
 
@@ -64,14 +65,14 @@ namespace repeat {
   };
 
   // Finite repeat case (explicitely limited with the number of times)
-  template <class T, class Observable, class Count>
+  template <class T, class Observable, class Count, class Iterations = retry_repeat_common::fresh_iterations>
   using finite = ::rxcpp::operators::detail::retry_repeat_common::finite
-    <event_handlers, T, Observable, Count>;
+    <event_handlers, T, Observable, Count, Iterations>;
   
   // Infinite repeat case
-  template <class T, class Observable>
+  template <class T, class Observable, class Iterations = retry_repeat_common::fresh_iterations>
   using infinite = ::rxcpp::operators::detail::retry_repeat_common::infinite
-    <event_handlers, T, Observable>;
+    <event_handlers, T, Observable, Iterations>;
 
 }
 } // detail
@@ -100,7 +101,7 @@ struct member_overload<repeat_tag> {
 
   template<class Observable,
            class Count,
-           class Enabled = rxu::enable_if_all_true_type_t<is_observable<Observable>>,
+           class Enabled = rxu::enable_if_all_true_type_t<is_observable<Observable>, rxu::negation<std::is_same<rxu::decay_t<Count>, reuse_arena>>>,
            class SourceValue = rxu::value_type_t<Observable>,
            class Repeat = rxo::detail::repeat::finite<SourceValue, rxu::decay_t<Observable>, rxu::decay_t<Count>>,
            class Value = rxu::value_type_t<Repeat>,
@@ -109,11 +110,32 @@ struct member_overload<repeat_tag> {
     return Result(Repeat(std::forward<Observable>(o), std::forward<Count>(c)));
   }
 
+  template<class Observable,
+           class Enabled = rxu::enable_if_all_true_type_t<is_observable<Observable>>,
+           class SourceValue = rxu::value_type_t<Observable>,
+           class Repeat = rxo::detail::repeat::infinite<SourceValue, rxu::decay_t<Observable>, rxo::detail::retry_repeat_common::recycled_iterations>,
+           class Value = rxu::value_type_t<Repeat>,
+           class Result = observable<Value, Repeat>>
+  static Result member(Observable&& o, reuse_arena) {
+    return Result(Repeat(std::forward<Observable>(o)));
+  }
+
+  template<class Observable,
+           class Count,
+           class Enabled = rxu::enable_if_all_true_type_t<is_observable<Observable>>,
+           class SourceValue = rxu::value_type_t<Observable>,
+           class Repeat = rxo::detail::repeat::finite<SourceValue, rxu::decay_t<Observable>, rxu::decay_t<Count>, rxo::detail::retry_repeat_common::recycled_iterations>,
+           class Value = rxu::value_type_t<Repeat>,
+           class Result = observable<Value, Repeat>>
+  static Result member(Observable&& o, Count&& c, reuse_arena) {
+    return Result(Repeat(std::forward<Observable>(o), std::forward<Count>(c)));
+  }
+
   template<class... AN>
   static operators::detail::repeat_invalid_t<AN...> member(AN...) {
     std::terminate();
     return {};
-    static_assert(sizeof...(AN) == 10000, "repeat takes (optional Count)");
+    static_assert(sizeof...(AN) == 10000, "repeat takes (optional Count), (optional reuse_arena)");
   }
 };
 
@@ -13,9 +13,52 @@ namespace rxcpp {
     namespace detail {
 
       namespace retry_repeat_common {
+        // The default, each iteration allocates its subscriptions and operator states anew.
+        struct fresh_iterations {
+          template <class F>
+          void subscribe(F&& f) {
+            f();
+          }
+        };
+
+        // repeat(reuse_arena()) and retry(reuse_arena()), each iteration allocates its
+        // subscriptions and operator states from an arena that an earlier iteration used.
+        // The next iteration subscribes from inside the on_completed or on_error of the
+        // previous one, which still holds its states, so two arenas take turns. An arena
+        // that still has live states, or that is too small, is replaced.
+        struct recycled_iterations {
+          static const std::size_t max_capacity = 64 * 1024;
+
+          recycled_iterations()
+            : capacity(subscription_arena::default_capacity),
+              turn(0) {
+          }
+
+          template <class F>
+          void subscribe(F&& f) {
+            auto& arena = arenas[turn];
+            turn ^= 1;
+            if (arena.capacity() < capacity || !arena.rewind()) {
+              arena = subscription_arena(capacity);
+            }
+            {
+              arena_scope scope(arena);
+              f();
+            }
+            if (arena.used() > capacity - capacity / 8 && capacity < max_capacity) {
+              // probably full, some of the states went to the heap
+              capacity *= 2;
+            }
+          }
+
+          std::size_t capacity;
+          subscription_arena arenas[2];
+          int turn;
+        };
+
         // Structure to perform general retry/repeat operations on state
-        template <class Values, class Subscriber, class EventHandlers, class T>
-        struct state_type : public std::enable_shared_from_this<state_type<Values, Subscriber, EventHandlers, T>>,
+        template <class Values, class Subscriber, class EventHandlers, class T, class Iterations>
+        struct state_type : public std::enable_shared_from_this<state_type<Values, Subscriber, EventHandlers, T, Iterations>>,
                             public Values {
 
           typedef Subscriber output_type;
@@ -31,34 +74,37 @@ namespace rxcpp {
             state->out.remove(state->lifetime_token);
             state->source_lifetime.unsubscribe();
 
-            state->source_lifetime = composite_subscription();
-            state->lifetime_token = state->out.add(state->source_lifetime);
-
-            state->source.subscribe(
-                                    state->out,
-                                    state->source_lifetime,
-                                    // on_next
-                                    [state](auto&& t) {
-                                      state->out.on_next(std::forward<decltype(t)>(t));
-                                    },
-                                    // on_error
-                                    [state](rxu::error_ptr e) {
-                                      EventHandlers::on_error(state, e);
-                                    },
-                                    // on_completed
-                                    [state]() {
-                                      EventHandlers::on_completed(state);
-                                    }
-                                    );
+            state->iterations.subscribe([&](){
+              state->source_lifetime = composite_subscription();
+              state->lifetime_token = state->out.add(state->source_lifetime);
+
+              state->source.subscribe(
+                                      state->out,
+                                      state->source_lifetime,
+                                      // on_next
+                                      [state](auto&& t) {
+                                        state->out.on_next(std::forward<decltype(t)>(t));
+                                      },
+                                      // on_error
+                                      [state](rxu::error_ptr e) {
+                                        EventHandlers::on_error(state, e);
+                                      },
+                                      // on_completed
+                                      [state]() {
+                                        EventHandlers::on_completed(state);
+                                      }
+                                      );
+            });
           }
           
           composite_subscription source_lifetime;
           output_type out;
           composite_subscription::weak_subscription lifetime_token;
+          Iterations iterations;
         };
 
         // Finite case (explicitely limited with the number of times)
-        template <class EventHandlers, class T, class Observable, class Count>
+        template <class EventHandlers, class T, class Observable, class Count, class Iterations>
         struct finite : public operator_base<T> {
           typedef rxu::decay_t<Observable> source_type;
           typedef rxu::decay_t<Count> count_type;
@@ -92,9 +138,9 @@ namespace rxcpp {
 
           template<class Subscriber>
           void on_subscribe(const Subscriber& s) const {
-            typedef state_type<values, Subscriber, EventHandlers, T> state_t;
+            typedef state_type<values, Subscriber, EventHandlers, T, Iterations> state_t;
             // take a copy of the values for each subscription
-            auto state = std::make_shared<state_t>(initial_, s);      
+            auto state = rxu::make_arena_shared<state_t>(initial_, s);      
             if (initial_.completed_predicate()) {
               // return completed
               state->out.on_completed();
@@ -109,7 +155,7 @@ namespace rxcpp {
         };
 
         // Infinite case
-        template <class EventHandlers, class T, class Observable>
+        template <class EventHandlers, class T, class Observable, class Iterations>
         struct infinite : public operator_base<T> {
           typedef rxu::decay_t<Observable> source_type;
     
@@ -135,9 +181,9 @@ namespace rxcpp {
 
           template<class Subscriber>
           void on_subscribe(const Subscriber& s) const {
-            typedef state_type<values, Subscriber, EventHandlers, T> state_t;
+            typedef state_type<values, Subscriber, EventHandlers, T, Iterations> state_t;
             // take a copy of the values for each subscription
-            auto state = std::make_shared<state_t>(initial_, s);
+            auto state = rxu::make_arena_shared<state_t>(initial_, s);
             // start the first iteration
             state->do_subscribe();
           }
@@ -9,6 +9,7 @@
     \tparam Count the type of the counter (optional)
 
     \param t  the total number of tries (optional), i.e. retry(2) means one normal try, before an error occurs, and one retry. If not specified, infinitely retries the source observable. Specifying 0 returns immediately without subscribing
+    \param r  rxcpp::reuse_arena() (optional). Allocates the subscriptions and operator states of each try in memory reused from an earlier try, see rx-arena.hpp.
 
     \return  An observable that mirrors the source observable, resubscribing to it if it calls on_error up to a specified number of retries.
 
@@ -60,14 +61,14 @@ namespace retry {
   };
 
   // Finite repeat case (explicitely limited with the number of times)
-  template <class T, class Observable, class Count>
+  template <class T, class Observable, class Count, class Iterations = retry_repeat_common::fresh_iterations>
   using finite = ::rxcpp::operators::detail::retry_repeat_common::finite
-    <event_handlers, T, Observable, Count>;
+    <event_handlers, T, Observable, Count, Iterations>;
   
   // Infinite repeat case
-  template <class T, class Observable>
+  template <class T, class Observable, class Iterations = retry_repeat_common::fresh_iterations>
   using infinite = ::rxcpp::operators::detail::retry_repeat_common::infinite
-    <event_handlers, T, Observable>;
+    <event_handlers, T, Observable, Iterations>;
   
 }
 } // detail
@@ -98,7 +99,7 @@ struct member_overload<retry_tag>
 
   template<class Observable,
            class Count,
-           class Enabled = rxu::enable_if_all_true_type_t<is_observable<Observable>>,
+           class Enabled = rxu::enable_if_all_true_type_t<is_observable<Observable>, rxu::negation<std::is_same<rxu::decay_t<Count>, reuse_arena>>>,
            class SourceValue = rxu::value_type_t<Observable>,
            class Retry = rxo::detail::retry::finite<SourceValue, rxu::decay_t<Observable>, rxu::decay_t<Count>>,
            class Value = rxu::value_type_t<Retry>,
@@ -108,11 +109,32 @@ struct member_overload<retry_tag>
     return Result(Retry(std::forward<Observable>(o), std::forward<Count>(c)));
   }
 
+  template<class Observable,
+           class Enabled = rxu::enable_if_all_true_type_t<is_observable<Observable>>,
+           class SourceValue = rxu::value_type_t<Observable>,
+           class Retry = rxo::detail::retry::infinite<SourceValue, rxu::decay_t<Observable>, rxo::detail::retry_repeat_common::recycled_iterations>,
+           class Value = rxu::value_type_t<Retry>,
+           class Result = observable<Value, Retry>>
+  static Result member(Observable&& o, reuse_arena) {
+    return Result(Retry(std::forward<Observable>(o)));
+  }
+
+  template<class Observable,
+           class Count,
+           class Enabled = rxu::enable_if_all_true_type_t<is_observable<Observable>>,
+           class SourceValue = rxu::value_type_t<Observable>,
+           class Retry = rxo::detail::retry::finite<SourceValue, rxu::decay_t<Observable>, rxu::decay_t<Count>, rxo::detail::retry_repeat_common::recycled_iterations>,
+           class Value = rxu::value_type_t<Retry>,
+           class Result = observable<Value, Retry>>
+  static Result member(Observable&& o, Count&& c, reuse_arena) {
+    return Result(Retry(std::forward<Observable>(o), std::forward<Count>(c)));
+  }
+
   template<class... AN>
   static operators::detail::retry_invalid_t<AN...> member(const AN&...) {
     std::terminate();
     return {};
-    static_assert(sizeof...(AN) == 10000, "retry takes (optional Count)");
+    static_assert(sizeof...(AN) == 10000, "retry takes (optional Count), (optional reuse_arena)");
   } 
 };
     
@@ -81,7 +81,7 @@ struct scan : public operator_base<rxu::decay_t<Seed>>
             seed_type result;
             Subscriber out;
         };
-        auto state = std::make_shared<scan_state_type>(initial, std::move(o));
+        auto state = rxu::make_arena_shared<scan_state_type>(initial, std::move(o));
         state->source.subscribe(
             state->out,
         // on_next
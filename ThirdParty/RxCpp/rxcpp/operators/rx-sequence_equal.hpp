@@ -107,7 +107,7 @@ struct sequence_equal : public operator_base<bool>
         };
 
         auto coordinator = initial.coordination.create_coordinator();
-        auto state = std::make_shared<state_type>(initial, std::move(coordinator), std::move(s));
+        auto state = rxu::make_arena_shared<state_type>(initial, std::move(coordinator), std::move(s));
 
         auto other = on_exception(
             [&](){ return state->coordinator.in(state->other); },
@@ -47,6 +47,8 @@
     \snippet subscribe.cpp subscribe unsubscribe
     \snippet output.txt subscribe unsubscribe
 
+    Pass an rxcpp::subscription_arena first to allocate the states of the chain from one block, see rx-arena.hpp.
+
     For more details, see rxcpp::make_subscriber function description.
 */
 
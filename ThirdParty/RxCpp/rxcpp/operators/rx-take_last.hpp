@@ -81,7 +81,7 @@ struct take_last : public operator_base<T>
             output_type out;
         };
         // take a copy of the values for each subscription
-        auto state = std::make_shared<state_type>(initial, s);
+        auto state = rxu::make_arena_shared<state_type>(initial, s);
 
         composite_subscription source_lifetime;
 
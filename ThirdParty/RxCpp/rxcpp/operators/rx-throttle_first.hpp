@@ -0,0 +1,170 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-throttle_first.hpp
+
+    \brief  Return an observable that emits the first value of each window and drops the values that follow it until the window has passed.
+
+    \tparam Duration      the type of the time interval
+    \tparam Coordination  the type of the scheduler (optional)
+
+    \param period        the length of the window that starts with each emitted value
+    \param coordination  the scheduler whose clock decides when a window has passed (optional)
+
+    \return  Observable that emits the first value of each window.
+
+    \note Unlike throttle, nothing is scheduled. Each value compares the clock
+          with the end of the current window and is passed on or dropped in
+          the same call.
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_THROTTLE_FIRST_HPP)
+#define RXCPP_OPERATORS_RX_THROTTLE_FIRST_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct throttle_first_invalid_arguments {};
+
+template<class... AN>
+struct throttle_first_invalid : public rxo::operator_base<throttle_first_invalid_arguments<AN...>> {
+    using type = observable<throttle_first_invalid_arguments<AN...>, throttle_first_invalid<AN...>>;
+};
+template<class... AN>
+using throttle_first_invalid_t = typename throttle_first_invalid<AN...>::type;
+
+template<class T, class Duration, class Coordination>
+struct throttle_first
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef rxu::decay_t<Duration> duration_type;
+
+    duration_type period;
+    coordination_type coordination;
+
+    throttle_first(duration_type p, coordination_type cn)
+        : period(p)
+        , coordination(std::move(cn))
+    {
+    }
+
+    template<class Subscriber>
+    struct throttle_first_observer
+    {
+        typedef throttle_first_observer<Subscriber> this_type;
+        typedef source_value_type value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<value_type, this_type> observer_type;
+        typedef rxsc::scheduler::clock_type::time_point time_point_type;
+
+        dest_type dest;
+        duration_type period;
+        coordination_type coordination;
+        mutable time_point_type window_end;
+        mutable bool open;
+
+        throttle_first_observer(dest_type d, duration_type p, coordination_type cn)
+            : dest(std::move(d))
+            , period(p)
+            , coordination(std::move(cn))
+            , open(false)
+        {
+        }
+        template<typename U>
+        void on_next(U&& v) const {
+            auto now = coordination.now();
+            if (open && now < window_end) {
+                return;
+            }
+            open = true;
+            window_end = now + period;
+            dest.on_next(std::forward<U>(v));
+        }
+        void on_error(rxu::error_ptr e) const {
+            dest.on_error(e);
+        }
+        void on_completed() const {
+            dest.on_completed();
+        }
+
+        static subscriber<value_type, observer_type> make(dest_type d, duration_type p, coordination_type cn) {
+            return make_subscriber<value_type>(d, this_type(d, p, std::move(cn)));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(throttle_first_observer<Subscriber>::make(std::move(dest), period, coordination)) {
+        return      throttle_first_observer<Subscriber>::make(std::move(dest), period, coordination);
+    }
+};
+
+}
+
+/*! @copydoc rx-throttle_first.hpp
+*/
+template<class... AN>
+auto throttle_first(AN&&... an)
+    ->      operator_factory<throttle_first_tag, AN...> {
+     return operator_factory<throttle_first_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<throttle_first_tag>
+{
+    template<class Observable, class Duration,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            rxu::is_duration<Duration>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class ThrottleFirst = rxo::detail::throttle_first<SourceValue, rxu::decay_t<Duration>, identity_one_worker>>
+    static auto member(Observable&& o, Duration&& d)
+        -> decltype(o.template lift<SourceValue>(ThrottleFirst(std::forward<Duration>(d), identity_current_thread()))) {
+        return      o.template lift<SourceValue>(ThrottleFirst(std::forward<Duration>(d), identity_current_thread()));
+    }
+
+    template<class Observable, class Coordination, class Duration,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_coordination<Coordination>,
+            rxu::is_duration<Duration>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class ThrottleFirst = rxo::detail::throttle_first<SourceValue, rxu::decay_t<Duration>, rxu::decay_t<Coordination>>>
+    static auto member(Observable&& o, Coordination&& cn, Duration&& d)
+        -> decltype(o.template lift<SourceValue>(ThrottleFirst(std::forward<Duration>(d), std::forward<Coordination>(cn)))) {
+        return      o.template lift<SourceValue>(ThrottleFirst(std::forward<Duration>(d), std::forward<Coordination>(cn)));
+    }
+
+    template<class Observable, class Coordination, class Duration,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_coordination<Coordination>,
+            rxu::is_duration<Duration>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class ThrottleFirst = rxo::detail::throttle_first<SourceValue, rxu::decay_t<Duration>, rxu::decay_t<Coordination>>>
+    static auto member(Observable&& o, Duration&& d, Coordination&& cn)
+        -> decltype(o.template lift<SourceValue>(ThrottleFirst(std::forward<Duration>(d), std::forward<Coordination>(cn)))) {
+        return      o.template lift<SourceValue>(ThrottleFirst(std::forward<Duration>(d), std::forward<Coordination>(cn)));
+    }
+
+    template<class... AN>
+    static operators::detail::throttle_first_invalid_t<AN...> member(const AN&...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "throttle_first takes (optional Coordination, required Duration) or (required Duration, optional Coordination)");
+    }
+};
+
+}
+
+#endif
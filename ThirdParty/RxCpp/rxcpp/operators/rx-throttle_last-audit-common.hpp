@@ -0,0 +1,194 @@
+#pragma once
+
+/*! \file rx-throttle_last-audit-common.hpp
+
+    \brief Implementation commonalities between throttle_last and audit operators abstracted away from rx-throttle_last.hpp and rx-audit.hpp files. Should be used only from rx-throttle_last.hpp and rx-audit.hpp
+
+*/
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+namespace throttle_last_audit_common {
+
+// Both operators emit the latest value at the end of a window. The first
+// value of a window arms the only timer, later values in the same window just
+// replace the latest value. WindowPolicy::window_end picks the end of the
+// window that a value arriving at 'now' belongs to.
+template<class T, class Duration, class Coordination, class WindowPolicy>
+struct trailing
+{
+    typedef rxu::decay_t<T> source_value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef rxu::decay_t<Duration> duration_type;
+
+    struct trailing_values
+    {
+        trailing_values(duration_type p, coordination_type c)
+            : period(p)
+            , coordination(c)
+        {
+        }
+
+        duration_type period;
+        coordination_type coordination;
+    };
+    trailing_values initial;
+
+    trailing(duration_type period, coordination_type coordination)
+        : initial(period, coordination)
+    {
+    }
+
+    template<class Subscriber>
+    struct trailing_observer
+    {
+        typedef trailing_observer<Subscriber> this_type;
+        typedef rxu::decay_t<T> value_type;
+        typedef rxu::decay_t<Subscriber> dest_type;
+        typedef observer<T, this_type> observer_type;
+
+        struct trailing_subscriber_values : public trailing_values
+        {
+            trailing_subscriber_values(composite_subscription cs, dest_type d, trailing_values v, coordinator_type c)
+                : trailing_values(v)
+                , cs(std::move(cs))
+                , dest(std::move(d))
+                , coordinator(std::move(c))
+                , worker(coordinator.get_worker())
+                , origin(worker.now())
+                , armed(false)
+            {
+            }
+
+            composite_subscription cs;
+            dest_type dest;
+            coordinator_type coordinator;
+            rxsc::worker worker;
+            rxsc::scheduler::clock_type::time_point origin;
+            mutable std::mutex lock;
+            mutable rxu::maybe<value_type> latest;
+            mutable bool armed;
+        };
+        typedef std::shared_ptr<trailing_subscriber_values> state_type;
+        state_type state;
+
+        trailing_observer(composite_subscription cs, dest_type d, trailing_values v, coordinator_type c)
+            : state(std::make_shared<trailing_subscriber_values>(std::move(cs), std::move(d), v, std::move(c)))
+        {
+            auto localState = state;
+
+            auto disposer = [=](const rxsc::schedulable&){
+                localState->cs.unsubscribe();
+                localState->dest.unsubscribe();
+                localState->worker.unsubscribe();
+            };
+            auto selectedDisposer = on_exception(
+                [&](){ return localState->coordinator.act(disposer); },
+                localState->dest);
+            if (selectedDisposer.empty()) {
+                return;
+            }
+
+            localState->dest.add([=](){
+                localState->worker.schedule(selectedDisposer.get());
+            });
+            localState->cs.add([=](){
+                localState->worker.schedule(selectedDisposer.get());
+            });
+        }
+
+        static void emit_latest(const state_type& state) {
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->armed = false;
+            if (state->latest.empty()) {
+                return;
+            }
+            auto value = std::move(*state->latest);
+            state->latest.reset();
+            guard.unlock();
+            state->dest.on_next(std::move(value));
+        }
+
+        template<typename U>
+        void on_next(U&& v) const {
+            std::unique_lock<std::mutex> guard(state->lock);
+            state->latest.reset(std::forward<U>(v));
+            if (state->armed) {
+                return;
+            }
+
+            auto localState = state;
+            auto work = [localState](const rxsc::schedulable&){
+                emit_latest(localState);
+            };
+            auto selectedWork = on_exception(
+                [&](){ return localState->coordinator.act(work); },
+                localState->dest);
+            if (selectedWork.empty()) {
+                return;
+            }
+            state->armed = true;
+            auto when = WindowPolicy::window_end(state->origin, state->worker.now(), state->period);
+            guard.unlock();
+            state->worker.schedule(when, selectedWork.get());
+        }
+
+        void on_error(rxu::error_ptr e) const {
+            auto localState = state;
+            auto work = [e, localState](const rxsc::schedulable&){
+                localState->dest.on_error(e);
+            };
+            auto selectedWork = on_exception(
+                [&](){ return localState->coordinator.act(work); },
+                localState->dest);
+            if (selectedWork.empty()) {
+                return;
+            }
+            localState->worker.schedule(selectedWork.get());
+        }
+
+        void on_completed() const {
+            auto localState = state;
+            auto work = [localState](const rxsc::schedulable&){
+                // the value of an unfinished window is not lost
+                emit_latest(localState);
+                localState->dest.on_completed();
+            };
+            auto selectedWork = on_exception(
+                [&](){ return localState->coordinator.act(work); },
+                localState->dest);
+            if (selectedWork.empty()) {
+                return;
+            }
+            localState->worker.schedule(selectedWork.get());
+        }
+
+        static subscriber<T, observer_type> make(dest_type d, trailing_values v) {
+            auto cs = composite_subscription();
+            auto coordinator = v.coordination.create_coordinator();
+
+            return make_subscriber<T>(cs, observer_type(this_type(cs, std::move(d), std::move(v), std::move(coordinator))));
+        }
+    };
+
+    template<class Subscriber>
+    auto operator()(Subscriber dest) const
+        -> decltype(trailing_observer<Subscriber>::make(std::move(dest), initial)) {
+        return      trailing_observer<Subscriber>::make(std::move(dest), initial);
+    }
+};
+
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-throttle_last.hpp
+
+    \brief  Return an observable that emits the latest value of each fixed period in which the source emitted.
+
+    \tparam Duration      the type of the time interval
+    \tparam Coordination  the type of the scheduler (optional)
+
+    \param period        the length of the periods, counted from the time of subscription
+    \param coordination  the scheduler that emits at the end of each period (optional)
+
+    \return  Observable that emits the latest value at the end of each period that had a value, and that
+             emits the pending value before it completes.
+
+    \note Periods without values schedule nothing. A period with values schedules exactly one action.
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_THROTTLE_LAST_HPP)
+#define RXCPP_OPERATORS_RX_THROTTLE_LAST_HPP
+
+#include "../rx-includes.hpp"
+#include "rx-throttle_last-audit-common.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct throttle_last_invalid_arguments {};
+
+template<class... AN>
+struct throttle_last_invalid : public rxo::operator_base<throttle_last_invalid_arguments<AN...>> {
+    using type = observable<throttle_last_invalid_arguments<AN...>, throttle_last_invalid<AN...>>;
+};
+template<class... AN>
+using throttle_last_invalid_t = typename throttle_last_invalid<AN...>::type;
+
+namespace throttle_last {
+  // periods are a fixed grid that starts at subscription
+  struct window_policy {
+    template<class TimePoint, class Duration>
+    static TimePoint window_end(TimePoint origin, TimePoint now, Duration period) {
+      auto step = std::chrono::duration_cast<typename TimePoint::duration>(period);
+      if (step <= TimePoint::duration::zero()) {
+        return now;
+      }
+      return origin + step * ((now - origin) / step + 1);
+    }
+  };
+
+  template<class T, class Duration, class Coordination>
+  using trailing = ::rxcpp::operators::detail::throttle_last_audit_common::trailing
+    <T, Duration, Coordination, window_policy>;
+}
+
+}
+
+/*! @copydoc rx-throttle_last.hpp
+*/
+template<class... AN>
+auto throttle_last(AN&&... an)
+    ->      operator_factory<throttle_last_tag, AN...> {
+     return operator_factory<throttle_last_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<throttle_last_tag>
+{
+    template<class Observable, class Duration,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            rxu::is_duration<Duration>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class ThrottleLast = rxo::detail::throttle_last::trailing<SourceValue, rxu::decay_t<Duration>, identity_one_worker>>
+    static auto member(Observable&& o, Duration&& d)
+        -> decltype(o.template lift<SourceValue>(ThrottleLast(std::forward<Duration>(d), identity_current_thread()))) {
+        return      o.template lift<SourceValue>(ThrottleLast(std::forward<Duration>(d), identity_current_thread()));
+    }
+
+    template<class Observable, class Coordination, class Duration,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_coordination<Coordination>,
+            rxu::is_duration<Duration>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class ThrottleLast = rxo::detail::throttle_last::trailing<SourceValue, rxu::decay_t<Duration>, rxu::decay_t<Coordination>>>
+    static auto member(Observable&& o, Coordination&& cn, Duration&& d)
+        -> decltype(o.template lift<SourceValue>(ThrottleLast(std::forward<Duration>(d), std::forward<Coordination>(cn)))) {
+        return      o.template lift<SourceValue>(ThrottleLast(std::forward<Duration>(d), std::forward<Coordination>(cn)));
+    }
+
+    template<class Observable, class Coordination, class Duration,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            is_observable<Observable>,
+            is_coordination<Coordination>,
+            rxu::is_duration<Duration>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class ThrottleLast = rxo::detail::throttle_last::trailing<SourceValue, rxu::decay_t<Duration>, rxu::decay_t<Coordination>>>
+    static auto member(Observable&& o, Duration&& d, Coordination&& cn)
+        -> decltype(o.template lift<SourceValue>(ThrottleLast(std::forward<Duration>(d), std::forward<Coordination>(cn)))) {
+        return      o.template lift<SourceValue>(ThrottleLast(std::forward<Duration>(d), std::forward<Coordination>(cn)));
+    }
+
+    template<class... AN>
+    static operators::detail::throttle_last_invalid_t<AN...> member(const AN&...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "throttle_last takes (optional Coordination, required Duration) or (required Duration, optional Coordination)");
+    }
+};
+
+}
+
+#endif
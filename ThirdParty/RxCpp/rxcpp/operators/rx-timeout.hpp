@@ -147,7 +147,7 @@ struct timeout
                 if(id != state->index)
                     return;
 
-                state->dest.on_error(rxu::make_error_ptr(rxcpp::timeout_error("timeout has occurred")));
+                state->dest.on_error(rxu::make_static_error_ptr<rxcpp::timeout_error>("timeout has occurred"));
             };
 
             auto selectedProduce = on_exception(
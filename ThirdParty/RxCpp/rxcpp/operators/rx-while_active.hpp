@@ -0,0 +1,252 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-while_active.hpp
+
+    \brief Pass on the items of the source observable between an item of the start observable and the next item of the end observable, as often as they alternate.
+
+    \tparam StartObservable  the type of the start observable
+    \tparam EndObservable    the type of the end observable
+    \tparam Coordination     the type of the scheduler (optional)
+
+    \param start         the observable whose items open the gate
+    \param end           the observable whose items close the gate
+    \param coordination  the scheduler to synchronize the three observables (optional)
+
+    \return  Observable that emits the items of the source observable that arrive while the gate is open.
+
+    \note This replaces skip_until(start).take_until(end).repeat(). The source, start and end are
+          subscribed once, opening and closing the gate only flips a flag.
+*/
+
+#if !defined(RXCPP_OPERATORS_RX_WHILE_ACTIVE_HPP)
+#define RXCPP_OPERATORS_RX_WHILE_ACTIVE_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace operators {
+
+namespace detail {
+
+template<class... AN>
+struct while_active_invalid_arguments {};
+
+template<class... AN>
+struct while_active_invalid : public rxo::operator_base<while_active_invalid_arguments<AN...>> {
+    using type = observable<while_active_invalid_arguments<AN...>, while_active_invalid<AN...>>;
+};
+template<class... AN>
+using while_active_invalid_t = typename while_active_invalid<AN...>::type;
+
+template<class T, class Observable, class StartObservable, class EndObservable, class Coordination>
+struct while_active : public operator_base<T>
+{
+    typedef rxu::decay_t<T> value_type;
+    typedef rxu::decay_t<Observable> source_type;
+    typedef rxu::decay_t<StartObservable> start_source_type;
+    typedef rxu::decay_t<EndObservable> end_source_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    struct values
+    {
+        values(source_type s, start_source_type st, end_source_type e, coordination_type sf)
+            : source(std::move(s))
+            , start(std::move(st))
+            , end(std::move(e))
+            , coordination(std::move(sf))
+        {
+        }
+        source_type source;
+        start_source_type start;
+        end_source_type end;
+        coordination_type coordination;
+    };
+    values initial;
+
+    while_active(source_type s, start_source_type st, end_source_type e, coordination_type sf)
+        : initial(std::move(s), std::move(st), std::move(e), std::move(sf))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber s) const {
+
+        typedef Subscriber output_type;
+        struct while_active_state_type
+            : public std::enable_shared_from_this<while_active_state_type>
+            , public values
+        {
+            while_active_state_type(const values& i, coordinator_type coor, const output_type& oarg)
+                : values(i)
+                , active(false)
+                , coordinator(std::move(coor))
+                , out(oarg)
+            {
+                out.add(start_lifetime);
+                out.add(end_lifetime);
+                out.add(source_lifetime);
+            }
+            bool active;
+            composite_subscription start_lifetime;
+            composite_subscription end_lifetime;
+            composite_subscription source_lifetime;
+            coordinator_type coordinator;
+            output_type out;
+        };
+
+        auto coordinator = initial.coordination.create_coordinator(s.get_subscription());
+
+        // take a copy of the values for each subscription
+        auto state = rxu::make_arena_shared<while_active_state_type>(initial, std::move(coordinator), std::move(s));
+
+        auto start = on_exception(
+            [&](){return state->coordinator.in(state->start);},
+            state->out);
+        if (start.empty()) {
+            return;
+        }
+
+        auto end = on_exception(
+            [&](){return state->coordinator.in(state->end);},
+            state->out);
+        if (end.empty()) {
+            return;
+        }
+
+        auto source = on_exception(
+            [&](){return state->coordinator.in(state->source);},
+            state->out);
+        if (source.empty()) {
+            return;
+        }
+
+        auto sinkStart = make_subscriber<typename start_source_type::value_type>(
+        // share parts of subscription
+            state->out,
+        // new lifetime
+            state->start_lifetime,
+        // on_next
+            [state](const typename start_source_type::value_type&) {
+                state->active = true;
+            },
+        // on_error
+            [state](rxu::error_ptr e) {
+                state->out.on_error(e);
+            },
+        // on_completed
+            []() {
+            }
+        );
+        auto selectedSinkStart = on_exception(
+            [&](){return state->coordinator.out(sinkStart);},
+            state->out);
+        if (selectedSinkStart.empty()) {
+            return;
+        }
+        start->subscribe(std::move(selectedSinkStart.get()));
+
+        auto sinkEnd = make_subscriber<typename end_source_type::value_type>(
+        // share parts of subscription
+            state->out,
+        // new lifetime
+            state->end_lifetime,
+        // on_next
+            [state](const typename end_source_type::value_type&) {
+                state->active = false;
+            },
+        // on_error
+            [state](rxu::error_ptr e) {
+                state->out.on_error(e);
+            },
+        // on_completed
+            []() {
+            }
+        );
+        auto selectedSinkEnd = on_exception(
+            [&](){return state->coordinator.out(sinkEnd);},
+            state->out);
+        if (selectedSinkEnd.empty()) {
+            return;
+        }
+        end->subscribe(std::move(selectedSinkEnd.get()));
+
+        auto sinkSource = make_subscriber<T>(
+        // split subscription lifetime
+            state->source_lifetime,
+        // on_next
+            [state](const value_type& t) {
+                if (state->active) {
+                    state->out.on_next(t);
+                }
+            },
+        // on_error
+            [state](rxu::error_ptr e) {
+                state->out.on_error(e);
+            },
+        // on_completed
+            [state]() {
+                state->out.on_completed();
+            }
+        );
+        auto selectedSinkSource = on_exception(
+            [&](){return state->coordinator.out(sinkSource);},
+            state->out);
+        if (selectedSinkSource.empty()) {
+            return;
+        }
+        source->subscribe(std::move(selectedSinkSource.get()));
+    }
+};
+
+}
+
+/*! @copydoc rx-while_active.hpp
+*/
+template<class... AN>
+auto while_active(AN&&... an)
+    ->     operator_factory<while_active_tag, AN...> {
+    return operator_factory<while_active_tag, AN...>(std::make_tuple(std::forward<AN>(an)...));
+}
+
+}
+
+template<>
+struct member_overload<while_active_tag>
+{
+    template<class Observable, class StartObservable, class EndObservable,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            all_observables<Observable, StartObservable, EndObservable>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class WhileActive = rxo::detail::while_active<SourceValue, rxu::decay_t<Observable>, rxu::decay_t<StartObservable>, rxu::decay_t<EndObservable>, identity_one_worker>,
+        class Value = rxu::value_type_t<WhileActive>,
+        class Result = observable<Value, WhileActive>>
+    static Result member(Observable&& o, StartObservable&& st, EndObservable&& e) {
+        return Result(WhileActive(std::forward<Observable>(o), std::forward<StartObservable>(st), std::forward<EndObservable>(e), identity_current_thread()));
+    }
+
+    template<class Observable, class StartObservable, class EndObservable, class Coordination,
+        class Enabled = rxu::enable_if_all_true_type_t<
+            all_observables<Observable, StartObservable, EndObservable>,
+            is_coordination<Coordination>>,
+        class SourceValue = rxu::value_type_t<Observable>,
+        class WhileActive = rxo::detail::while_active<SourceValue, rxu::decay_t<Observable>, rxu::decay_t<StartObservable>, rxu::decay_t<EndObservable>, rxu::decay_t<Coordination>>,
+        class Value = rxu::value_type_t<WhileActive>,
+        class Result = observable<Value, WhileActive>>
+    static Result member(Observable&& o, StartObservable&& st, EndObservable&& e, Coordination&& cn) {
+        return Result(WhileActive(std::forward<Observable>(o), std::forward<StartObservable>(st), std::forward<EndObservable>(e), std::forward<Coordination>(cn)));
+    }
+
+    template<class... AN>
+    static operators::detail::while_active_invalid_t<AN...> member(AN...) {
+        std::terminate();
+        return {};
+        static_assert(sizeof...(AN) == 10000, "while_active takes (StartObservable, EndObservable, optional Coordination)");
+    }
+};
+
+}
+
+#endif
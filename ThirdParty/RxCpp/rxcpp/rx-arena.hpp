@@ -0,0 +1,307 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-arena.hpp
+
+    \brief Allocates the state of a subscription chain from one block.
+
+    Subscribing a chain creates a shared state for each subscription, each subscriber and most operators.
+    When a subscription_arena is active these are carved from the arena's block instead of the heap. The
+    block is freed in one call, after the arena and every state allocated from it have been released.
+
+    rxcpp::subscription_arena arena;
+    auto lifetime = CameraMoveStream.subscribe(arena, [](const FVector2D& v){...});
+
+    Only states created on the subscribing thread while the arena is active are placed in the arena. This
+    includes states created by values that the source emits synchronously during subscribe. States created
+    later, on other threads, or by schedulers, use the heap. A scheduler, and the event loop threads that
+    it starts on demand, outlive the chain even when they are first created during its subscribe, eg. by
+    the first observe_on_event_loop(). Subjects and other states that are created during subscribe and kept
+    after the chain has ended pin the whole block, create them before the arena is active. When the block
+    is full the remaining states use the heap as well.
+
+    Space from a state that is released early is only reclaimed with the whole block, or by rewind() once
+    every state allocated from the block has been released. repeat(reuse_arena()) and retry(reuse_arena())
+    rewind two arenas in turn, so each iteration reuses the memory of the states of an earlier one.
+*/
+
+#if !defined(RXCPP_RX_ARENA_HPP)
+#define RXCPP_RX_ARENA_HPP
+
+#include "rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace detail {
+
+struct alignas(std::max_align_t) arena_block
+{
+    // one reference for the subscription_arena and one for each allocation that has not been deallocated.
+    std::atomic<std::size_t> refs;
+    std::atomic<std::size_t> used;
+    const std::size_t capacity;
+
+    explicit arena_block(std::size_t c)
+        : refs(1)
+        , used(0)
+        , capacity(c)
+    {
+    }
+
+    static arena_block* create(std::size_t capacity) {
+        return new (::operator new(sizeof(arena_block) + capacity)) arena_block(capacity);
+    }
+
+    unsigned char* data() {
+        return reinterpret_cast<unsigned char*>(this + 1);
+    }
+
+    // returns nullptr when the block does not have room.
+    void* allocate(std::size_t size, std::size_t align) {
+        if (align > alignof(std::max_align_t) || size > capacity) {
+            return nullptr;
+        }
+        auto offset = used.load(std::memory_order_relaxed);
+        std::size_t begin;
+        do {
+            begin = (offset + align - 1) & ~(align - 1);
+            if (begin > capacity - size) {
+                return nullptr;
+            }
+        } while (!used.compare_exchange_weak(offset, begin + size, std::memory_order_relaxed));
+        refs.fetch_add(1, std::memory_order_relaxed);
+        return data() + begin;
+    }
+
+    // only the owner may rewind, and only while nothing else refers to the block.
+    bool rewind() {
+        if (refs.load(std::memory_order_acquire) != 1) {
+            return false;
+        }
+        used.store(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    void release() {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            this->~arena_block();
+            ::operator delete(this);
+        }
+    }
+
+#if defined(RXCPP_THREAD_LOCAL)
+    static arena_block*& current() {
+        static RXCPP_THREAD_LOCAL arena_block* a;
+        return a;
+    }
+#else
+    struct current_type
+    {
+        rxu::thread_local_storage<arena_block> a;
+        current_type& operator=(arena_block* b) {
+            a = b;
+            return *this;
+        }
+        operator arena_block*() {
+            return a.get();
+        }
+    };
+    static current_type& current() {
+        static current_type a;
+        return a;
+    }
+#endif
+};
+
+}
+
+/*!
+    \brief one block that the states of the chains subscribed while it is active are allocated from.
+
+    \ingroup group-core
+
+*/
+class subscription_arena
+{
+    detail::arena_block* block;
+
+    subscription_arena(const subscription_arena&);
+    subscription_arena& operator=(const subscription_arena&);
+
+    friend class arena_scope;
+
+public:
+    static const std::size_t default_capacity = 4096;
+
+    explicit subscription_arena(std::size_t capacity = default_capacity)
+        : block(detail::arena_block::create(capacity))
+    {
+    }
+    subscription_arena(subscription_arena&& o)
+        : block(o.block)
+    {
+        o.block = nullptr;
+    }
+    subscription_arena& operator=(subscription_arena&& o)
+    {
+        std::swap(block, o.block);
+        return *this;
+    }
+    /// the block is freed when the last state allocated from it is released.
+    ~subscription_arena()
+    {
+        if (block) {
+            block->release();
+        }
+    }
+
+    std::size_t capacity() const {
+        return block ? block->capacity : 0;
+    }
+    /// bytes handed out so far, including alignment padding.
+    std::size_t used() const {
+        return block ? block->used.load(std::memory_order_relaxed) : 0;
+    }
+
+    /// make the whole block available again. fails while a state allocated from it is alive.
+    bool rewind() {
+        return block && block->rewind();
+    }
+};
+
+/*!
+    \brief pass to repeat or retry to subscribe each iteration from a recycled subscription_arena.
+
+    \ingroup group-core
+
+*/
+struct reuse_arena {};
+
+/*!
+    \brief makes an arena the active arena for the current thread until the scope ends.
+
+    \ingroup group-core
+
+*/
+class arena_scope
+{
+    detail::arena_block* previous;
+
+    arena_scope(const arena_scope&);
+    arena_scope& operator=(const arena_scope&);
+
+public:
+    explicit arena_scope(subscription_arena& a)
+        : previous(detail::arena_block::current())
+    {
+        if (!a.block) {
+            std::terminate();
+        }
+        detail::arena_block::current() = a.block;
+    }
+    ~arena_scope()
+    {
+        detail::arena_block::current() = previous;
+    }
+};
+
+namespace detail {
+
+// suspends the active arena for states that outlive the chain being subscribed.
+class heap_scope
+{
+    arena_block* previous;
+
+    heap_scope(const heap_scope&);
+    heap_scope& operator=(const heap_scope&);
+
+public:
+    heap_scope()
+        : previous(arena_block::current())
+    {
+        arena_block::current() = nullptr;
+    }
+    ~heap_scope()
+    {
+        arena_block::current() = previous;
+    }
+};
+
+}
+
+namespace util {
+
+/// allocates from the arena that was active when the allocator was created, or from the heap.
+template<class T>
+class arena_allocator
+{
+    template<class U>
+    friend class arena_allocator;
+
+    rxcpp::detail::arena_block* block;
+    // the block may be freed while an allocation that fell back to the heap
+    // is alive, so deallocate tells them apart by address without reading it.
+    std::size_t capacity;
+
+    bool owns(const void* p) const {
+        auto b = reinterpret_cast<std::uintptr_t>(block) + sizeof(rxcpp::detail::arena_block);
+        auto a = reinterpret_cast<std::uintptr_t>(p);
+        return a >= b && a < b + capacity;
+    }
+
+public:
+    typedef T value_type;
+
+    arena_allocator()
+        : block(rxcpp::detail::arena_block::current())
+        , capacity(block ? block->capacity : 0)
+    {
+    }
+    template<class U>
+    arena_allocator(const arena_allocator<U>& o)
+        : block(o.block)
+        , capacity(o.capacity)
+    {
+    }
+
+    T* allocate(std::size_t n) {
+        if (block) {
+            if (void* p = block->allocate(n * sizeof(T), alignof(T))) {
+                return static_cast<T*>(p);
+            }
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, std::size_t) {
+        if (block && owns(p)) {
+            block->release();
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    template<class U>
+    bool operator==(const arena_allocator<U>& o) const {
+        return block == o.block;
+    }
+    template<class U>
+    bool operator!=(const arena_allocator<U>& o) const {
+        return block != o.block;
+    }
+};
+
+/// make_shared that uses the active subscription_arena, when there is one.
+template<class T, class... AN>
+std::shared_ptr<T> make_arena_shared(AN&&... an) {
+    if (!rxcpp::detail::arena_block::current()) {
+        return std::make_shared<T>(std::forward<AN>(an)...);
+    }
+    return std::allocate_shared<T>(arena_allocator<T>(), std::forward<AN>(an)...);
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,378 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-confined.hpp
+
+    \brief Reference counted pointers, flags and locks for subscriptions that never leave one thread.
+
+    By default every copy of a subscription or subscriber changes a std::shared_ptr count with an atomic
+    operation, and every is_subscribed() loads a std::atomic<bool>. Define RXCPP_THREAD_CONFINED to
+    replace them, in subscription and composite_subscription, with the plain counts and flags in this
+    header and to remove the lock in composite_subscription.
+
+    RXCPP_THREAD_CONFINED is for programs whose subscriptions are created, copied, unsubscribed and
+    released on one thread, such as a game thread that uses the run_loop, frame_clock, current_thread or
+    immediate schedulers. It must not be defined when event_loop, new_thread or any other scheduler that
+    moves subscribers to another thread is used.
+
+    Unless NDEBUG is defined, each count and flag remembers the thread that created it and calls
+    std::terminate() when it is used from another thread.
+*/
+
+#if !defined(RXCPP_RX_CONFINED_HPP)
+#define RXCPP_RX_CONFINED_HPP
+
+#include "rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace util {
+
+namespace detail {
+
+struct confined_owner
+{
+#if !defined(NDEBUG)
+    std::thread::id owner;
+
+    confined_owner()
+        : owner(std::this_thread::get_id())
+    {
+    }
+    void check() const {
+        if (owner != std::this_thread::get_id()) {
+            // confined state was shared across threads
+            std::terminate();
+        }
+    }
+#else
+    void check() const {
+    }
+#endif
+};
+
+struct confined_count : public confined_owner
+{
+    // strong references, and weak references plus one for all the strong references.
+    long strong;
+    long weak;
+
+    confined_count()
+        : strong(1)
+        , weak(1)
+    {
+    }
+
+    void add_ref() {
+        check();
+        ++strong;
+    }
+    void release() {
+        check();
+        if (--strong == 0) {
+            destroy();
+            release_weak();
+        }
+    }
+    void add_weak() {
+        check();
+        ++weak;
+    }
+    void release_weak() {
+        check();
+        if (--weak == 0) {
+            deallocate();
+        }
+    }
+    bool try_add_ref() {
+        check();
+        if (strong == 0) {
+            return false;
+        }
+        ++strong;
+        return true;
+    }
+
+    virtual void destroy() = 0;
+    virtual void deallocate() = 0;
+
+protected:
+    virtual ~confined_count() {}
+};
+
+template<class T, class Allocator>
+struct confined_block : public confined_count
+{
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<confined_block> allocator_type;
+    typedef std::allocator_traits<allocator_type> traits_type;
+
+    allocator_type allocator;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    explicit confined_block(const allocator_type& a)
+        : allocator(a)
+    {
+    }
+
+    T* get() {
+        return reinterpret_cast<T*>(storage);
+    }
+
+    virtual void destroy() {
+        get()->~T();
+    }
+    virtual void deallocate() {
+        allocator_type a(std::move(allocator));
+        this->~confined_block();
+        traits_type::deallocate(a, this, 1);
+    }
+};
+
+}
+
+template<class T>
+class confined_weak_ptr;
+
+/// a std::shared_ptr whose count is not atomic.
+template<class T>
+class confined_ptr
+{
+    template<class U>
+    friend class confined_ptr;
+    template<class U>
+    friend class confined_weak_ptr;
+    template<class U, class Allocator, class... AN>
+    friend confined_ptr<U> allocate_confined(const Allocator&, AN&&...);
+
+    T* p;
+    detail::confined_count* c;
+
+    // adopts a reference
+    confined_ptr(T* tp, detail::confined_count* tc)
+        : p(tp)
+        , c(tc)
+    {
+    }
+
+public:
+    typedef T element_type;
+
+    confined_ptr()
+        : p(nullptr)
+        , c(nullptr)
+    {
+    }
+    confined_ptr(std::nullptr_t)
+        : p(nullptr)
+        , c(nullptr)
+    {
+    }
+    confined_ptr(const confined_ptr& o)
+        : p(o.p)
+        , c(o.c)
+    {
+        if (c) {
+            c->add_ref();
+        }
+    }
+    confined_ptr(confined_ptr&& o)
+        : p(o.p)
+        , c(o.c)
+    {
+        o.p = nullptr;
+        o.c = nullptr;
+    }
+    template<class U>
+    confined_ptr(const confined_ptr<U>& o, typename std::enable_if<std::is_convertible<U*, T*>::value, void**>::type = nullptr)
+        : p(o.p)
+        , c(o.c)
+    {
+        if (c) {
+            c->add_ref();
+        }
+    }
+    template<class U>
+    confined_ptr(confined_ptr<U>&& o, typename std::enable_if<std::is_convertible<U*, T*>::value, void**>::type = nullptr)
+        : p(o.p)
+        , c(o.c)
+    {
+        o.p = nullptr;
+        o.c = nullptr;
+    }
+    ~confined_ptr()
+    {
+        if (c) {
+            c->release();
+        }
+    }
+    confined_ptr& operator=(confined_ptr o) {
+        std::swap(p, o.p);
+        std::swap(c, o.c);
+        return *this;
+    }
+
+    T* get() const {
+        return p;
+    }
+    T* operator->() const {
+        return p;
+    }
+    T& operator*() const {
+        return *p;
+    }
+    explicit operator bool() const {
+        return p != nullptr;
+    }
+    bool operator!() const {
+        return p == nullptr;
+    }
+};
+
+template<class T, class U>
+bool operator==(const confined_ptr<T>& lhs, const confined_ptr<U>& rhs) {
+    return lhs.get() == rhs.get();
+}
+template<class T, class U>
+bool operator!=(const confined_ptr<T>& lhs, const confined_ptr<U>& rhs) {
+    return lhs.get() != rhs.get();
+}
+template<class T, class U>
+bool operator<(const confined_ptr<T>& lhs, const confined_ptr<U>& rhs) {
+    return std::less<const void*>()(lhs.get(), rhs.get());
+}
+
+/// a std::weak_ptr for confined_ptr.
+template<class T>
+class confined_weak_ptr
+{
+    template<class U>
+    friend class confined_weak_ptr;
+
+    T* p;
+    detail::confined_count* c;
+
+public:
+    typedef T element_type;
+
+    confined_weak_ptr()
+        : p(nullptr)
+        , c(nullptr)
+    {
+    }
+    template<class U>
+    confined_weak_ptr(const confined_ptr<U>& o, typename std::enable_if<std::is_convertible<U*, T*>::value, void**>::type = nullptr)
+        : p(o.p)
+        , c(o.c)
+    {
+        if (c) {
+            c->add_weak();
+        }
+    }
+    confined_weak_ptr(const confined_weak_ptr& o)
+        : p(o.p)
+        , c(o.c)
+    {
+        if (c) {
+            c->add_weak();
+        }
+    }
+    confined_weak_ptr(confined_weak_ptr&& o)
+        : p(o.p)
+        , c(o.c)
+    {
+        o.p = nullptr;
+        o.c = nullptr;
+    }
+    ~confined_weak_ptr()
+    {
+        if (c) {
+            c->release_weak();
+        }
+    }
+    confined_weak_ptr& operator=(confined_weak_ptr o) {
+        std::swap(p, o.p);
+        std::swap(c, o.c);
+        return *this;
+    }
+
+    bool expired() const {
+        return !c || c->strong == 0;
+    }
+    confined_ptr<T> lock() const {
+        if (c && c->try_add_ref()) {
+            return confined_ptr<T>(p, c);
+        }
+        return confined_ptr<T>();
+    }
+};
+
+/// std::allocate_shared for confined_ptr.
+template<class T, class Allocator, class... AN>
+confined_ptr<T> allocate_confined(const Allocator& a, AN&&... an) {
+    typedef detail::confined_block<T, Allocator> block_type;
+    typename block_type::allocator_type alloc(a);
+    auto b = block_type::traits_type::allocate(alloc, 1);
+    ::new (static_cast<void*>(b)) block_type(alloc);
+    RXCPP_TRY {
+        ::new (static_cast<void*>(b->get())) T(std::forward<AN>(an)...);
+    } RXCPP_CATCH(...) {
+        b->~block_type();
+        block_type::traits_type::deallocate(alloc, b, 1);
+        rethrow_current_exception();
+    }
+    return confined_ptr<T>(b->get(), b);
+}
+
+/// a bool with the interface of the std::atomic<bool> members that subscriptions use.
+class confined_flag : public detail::confined_owner
+{
+    bool value;
+
+    confined_flag(const confined_flag&);
+    confined_flag& operator=(const confined_flag&);
+
+public:
+    explicit confined_flag(bool v)
+        : value(v)
+    {
+    }
+
+    bool load() const {
+        check();
+        return value;
+    }
+    operator bool() const {
+        return load();
+    }
+    bool exchange(bool v) {
+        check();
+        std::swap(value, v);
+        return v;
+    }
+    confined_flag& operator=(bool v) {
+        check();
+        value = v;
+        return *this;
+    }
+};
+
+/// a lock that does nothing.
+struct confined_mutex : public detail::confined_owner
+{
+    void lock() {
+        check();
+    }
+    bool try_lock() {
+        check();
+        return true;
+    }
+    void unlock() {
+    }
+};
+
+}
+
+}
+
+#endif
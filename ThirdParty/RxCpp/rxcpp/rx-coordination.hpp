@@ -181,6 +181,10 @@ inline identity_one_worker identity_same_worker(rxsc::worker w) {
     return identity_one_worker(rxsc::make_same_worker(w));
 }
 
+inline identity_one_worker identity_frame_clock(const rxsc::frame_clock& fc) {
+    return identity_one_worker(rxsc::make_frame_clock(fc));
+}
+
 class serialize_one_worker : public coordination_base
 {
     rxsc::scheduler factory;
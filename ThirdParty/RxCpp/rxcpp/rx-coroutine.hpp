@@ -10,6 +10,20 @@
         printf("%d\n", c);
     }
 
+    C++20 dropped `for co_await`. When the standard `<coroutine>` header is
+    available (RXCPP_USE_STD_COROUTINES) the same iterator is driven by hand:
+
+    auto o = interval(seconds(1), observe_on_event_loop()) | take(3);
+    for (auto it = co_await std::begin(o); it != std::end(o); co_await ++it) {
+        printf("%d\n", *it);
+    }
+
+    The standard flavor also adds `co_await resume_on(scheduler)` to hop
+    threads, `co_await next_frame(frame_clock)` and
+    `co_await delay(frame_clock, 200ms)` to wait on the game loop, and
+    `task<T>`, a lazy coroutine result that can be awaited or turned into an
+    observable with `from_task`.
+
 */
 
 #if !defined(RXCPP_RX_COROUTINE_HPP)
@@ -17,7 +31,530 @@
 
 #include "rx-includes.hpp"
 
-#ifdef _RESUMABLE_FUNCTIONS_SUPPORTED
+#if RXCPP_USE_STD_COROUTINES
+
+#include <rxcpp/operators/rx-finally.hpp>
+
+#include <coroutine>
+
+namespace rxcpp {
+namespace coroutine {
+
+template<typename Source>
+struct co_observable_iterator;
+
+// The loop body always runs inside the on_next of the source, so the
+// current value is exposed by pointer and never copied or allocated.
+// The loop body must not suspend on anything but ++it, the source
+// would then emit while nobody is waiting.
+template<typename Source>
+struct co_observable_iterator_state : std::enable_shared_from_this<co_observable_iterator_state<Source>>
+{
+    using value_type = typename Source::value_type;
+
+    ~co_observable_iterator_state() {
+        lifetime.unsubscribe();
+    }
+    explicit co_observable_iterator_state(const Source& o) : o(o) {}
+
+    void resume() {
+        auto handle = caller;
+        caller = nullptr;
+        handle.resume();
+    }
+
+    std::coroutine_handle<> caller{};
+    composite_subscription lifetime{};
+    const value_type* value{nullptr};
+    rxu::error_ptr error{};
+    Source o;
+};
+
+template<typename Source>
+struct co_observable_inc_awaiter
+{
+    bool await_ready() const {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) const {
+        auto& state = *it->state;
+        if (!state.lifetime.is_subscribed()) {return false;}
+        state.caller = handle;
+        return true;
+    }
+
+    co_observable_iterator<Source>& await_resume() const;
+
+    co_observable_iterator<Source>* it;
+};
+
+template<typename Source>
+struct co_observable_iterator
+{
+    using iterator_category = std::input_iterator_tag;
+    using value_type = typename Source::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    co_observable_iterator() {}
+
+    explicit co_observable_iterator(const Source& o) : state(std::make_shared<co_observable_iterator_state<Source>>(o)) {}
+
+    co_observable_iterator(co_observable_iterator&&)=default;
+    co_observable_iterator& operator=(co_observable_iterator&&)=default;
+
+    co_observable_inc_awaiter<Source> operator++()
+    {
+        return co_observable_inc_awaiter<Source>{this};
+    }
+
+    co_observable_iterator& operator++(int) = delete;
+    // not implementing postincrement
+
+    bool operator==(co_observable_iterator const &rhs) const
+    {
+        return !!state && !rhs.state && !state->lifetime.is_subscribed();
+    }
+
+    bool operator!=(co_observable_iterator const &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    value_type const &operator*() const
+    {
+        return *(state->value);
+    }
+
+    value_type const *operator->() const
+    {
+        return std::addressof(operator*());
+    }
+
+    std::shared_ptr<co_observable_iterator_state<Source>> state;
+};
+
+template<typename Source>
+co_observable_iterator<Source>& co_observable_inc_awaiter<Source>::await_resume() const {
+    if (!!it->state->error) {rxu::rethrow_exception(it->state->error);}
+    return *it;
+}
+
+template<typename Source>
+struct co_observable_iterator_awaiter
+{
+    using iterator=co_observable_iterator<Source>;
+    using value_type=typename iterator::value_type;
+
+    explicit co_observable_iterator_awaiter(const Source& o) : it(o) {
+    }
+
+    bool await_ready() const {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        std::weak_ptr<co_observable_iterator_state<Source>> wst=it.state;
+        it.state->caller = handle;
+        // a synchronous source resumes the caller from inside subscribe,
+        // this awaiter may be gone by the time subscribe returns.
+        auto& state = *it.state;
+        state.o |
+            rxo::finally([wst](){
+                auto st = wst.lock();
+                if (st && !!st->caller) {
+                    st->resume();
+                }
+            }) |
+            rxo::subscribe<value_type>(
+                state.lifetime,
+                // next
+                [wst](const value_type& v){
+                    auto st = wst.lock();
+                    if (!st || !st->caller) {std::terminate();}
+                    st->value = std::addressof(v);
+                    st->resume();
+                },
+                // error
+                [wst](rxu::error_ptr e){
+                    auto st = wst.lock();
+                    if (!st || !st->caller) {std::terminate();}
+                    st->error = e;
+                    st->resume();
+                });
+    }
+
+    iterator await_resume() {
+        if (!!it.state->error) {rxu::rethrow_exception(it.state->error);}
+        return std::move(it);
+    }
+
+    iterator it;
+};
+
+struct resume_on_awaiter
+{
+    bool await_ready() const {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) const {
+        if (owned) {
+            // the worker was made for this hop only, release its thread once the coroutine suspends again.
+            auto w = controller;
+            w.schedule([handle, w](const rxsc::schedulable&){
+                handle.resume();
+                w.unsubscribe();
+            });
+        } else {
+            controller.schedule([handle](const rxsc::schedulable&){
+                handle.resume();
+            });
+        }
+    }
+
+    void await_resume() const {
+    }
+
+    rxsc::worker controller;
+    bool owned;
+};
+
+/// continue the awaiting coroutine on a new worker of the scheduler.
+inline resume_on_awaiter resume_on(const rxsc::scheduler& sc) {
+    return resume_on_awaiter{sc.create_worker(), true};
+}
+
+/// continue the awaiting coroutine on the worker.
+inline resume_on_awaiter resume_on(const rxsc::worker& w) {
+    return resume_on_awaiter{w, false};
+}
+
+/// continue the awaiting coroutine the next time the run_loop dispatches.
+inline resume_on_awaiter resume_on(const rxsc::run_loop& rl) {
+    return resume_on(rl.get_scheduler());
+}
+
+// frame_clock_awaiter is the intrusive node that the frame clock links
+// while the coroutine is suspended, so waiting allocates nothing.
+struct frame_clock_awaiter : public rxsc::detail::frame_clock_waiter
+{
+    typedef rxsc::scheduler::clock_type clock_type;
+
+    frame_clock_awaiter(const rxsc::frame_clock& fc, bool f, clock_type::time_point at)
+        : rxsc::detail::frame_clock_waiter(&frame_clock_awaiter::resume)
+        , state(std::addressof(fc.get_virtual_time()))
+        , per_frame(f)
+    {
+        when = at;
+    }
+    frame_clock_awaiter(const frame_clock_awaiter&) = delete;
+    frame_clock_awaiter& operator=(const frame_clock_awaiter&) = delete;
+    ~frame_clock_awaiter() {
+        // the coroutine was destroyed while suspended
+        if (list) {
+            state->cancel(*this);
+        }
+    }
+
+    bool await_ready() const {
+        return !per_frame && when <= state->now();
+    }
+
+    void await_suspend(std::coroutine_handle<> h) {
+        handle = h;
+        if (per_frame) {
+            state->wait_frame(*this);
+        } else {
+            state->wait_until(*this);
+        }
+    }
+
+    void await_resume() const {
+    }
+
+    static void resume(rxsc::detail::frame_clock_waiter* w) {
+        static_cast<frame_clock_awaiter*>(w)->handle.resume();
+    }
+
+    const rxsc::detail::frame_clock_state* state;
+    std::coroutine_handle<> handle{};
+    bool per_frame;
+};
+
+/// continue the awaiting coroutine in the next frame_clock::advance.
+inline frame_clock_awaiter next_frame(const rxsc::frame_clock& fc) {
+    return frame_clock_awaiter(fc, true, fc.now());
+}
+
+/// continue the awaiting coroutine once the frame clock has advanced by the delay.
+template<class Rep, class Period>
+frame_clock_awaiter delay(const rxsc::frame_clock& fc, std::chrono::duration<Rep, Period> d) {
+    return frame_clock_awaiter(fc, false, fc.now() + std::chrono::duration_cast<rxsc::scheduler::clock_type::duration>(d));
+}
+
+template<class T>
+class task;
+
+/// the value type of an observable made from a task<void>, it is never emitted.
+struct void_result {};
+
+namespace detail {
+
+struct task_promise_base
+{
+    struct final_awaiter
+    {
+        bool await_ready() const noexcept {
+            return false;
+        }
+        template<class Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+            auto continuation = handle.promise().continuation;
+            return !!continuation ? continuation : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {
+        }
+    };
+
+    std::suspend_always initial_suspend() const noexcept {
+        return {};
+    }
+    final_awaiter final_suspend() const noexcept {
+        return {};
+    }
+    void unhandled_exception() {
+        error = rxu::current_exception();
+    }
+
+    std::coroutine_handle<> continuation{};
+    rxu::error_ptr error{};
+};
+
+template<class T>
+struct task_promise : public task_promise_base
+{
+    task<T> get_return_object();
+
+    template<class U>
+    void return_value(U&& v) {
+        value.reset(std::forward<U>(v));
+    }
+
+    T result() {
+        if (!!error) {rxu::rethrow_exception(error);}
+        return std::move(*value);
+    }
+
+    rxu::maybe<T> value;
+};
+
+template<>
+struct task_promise<void> : public task_promise_base
+{
+    task<void> get_return_object();
+
+    void return_void() {
+    }
+
+    void result() {
+        if (!!error) {rxu::rethrow_exception(error);}
+    }
+};
+
+}
+
+/*!
+    \brief a lazily started coroutine that produces one T (or an error).
+
+    The body does not run until the task is awaited or subscribed through from_task().
+*/
+template<class T>
+class task
+{
+public:
+    using value_type = T;
+    using promise_type = detail::task_promise<T>;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    task() {}
+    explicit task(handle_type h) : handle(h) {}
+    task(task&& other) noexcept : handle(other.handle) {
+        other.handle = nullptr;
+    }
+    task& operator=(task&& other) noexcept {
+        if (this != std::addressof(other)) {
+            if (handle) {handle.destroy();}
+            handle = other.handle;
+            other.handle = nullptr;
+        }
+        return *this;
+    }
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+    ~task() {
+        if (handle) {handle.destroy();}
+    }
+
+    bool is_ready() const {
+        return !handle || handle.done();
+    }
+
+    struct settle_awaiter
+    {
+        bool await_ready() const {
+            return !handle || handle.done();
+        }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) const {
+            handle.promise().continuation = caller;
+            return handle;
+        }
+        promise_type& await_resume() const {
+            return handle.promise();
+        }
+        handle_type handle;
+    };
+
+    struct result_awaiter : public settle_awaiter
+    {
+        T await_resume() const {
+            return this->handle.promise().result();
+        }
+    };
+
+    /// run the task and resume with the promise, errors are not rethrown.
+    settle_awaiter settle() const {
+        return settle_awaiter{handle};
+    }
+
+    result_awaiter operator co_await() const {
+        return result_awaiter{{handle}};
+    }
+
+private:
+    handle_type handle{};
+};
+
+namespace detail {
+
+template<class T>
+task<T> task_promise<T>::get_return_object() {
+    return task<T>(task<T>::handle_type::from_promise(*this));
+}
+
+inline task<void> task_promise<void>::get_return_object() {
+    return task<void>(task<void>::handle_type::from_promise(*this));
+}
+
+// fire and forget coroutine used to drive a task into a subscriber.
+struct detached_task
+{
+    struct promise_type
+    {
+        detached_task get_return_object() const noexcept {
+            return {};
+        }
+        std::suspend_never initial_suspend() const noexcept {
+            return {};
+        }
+        std::suspend_never final_suspend() const noexcept {
+            return {};
+        }
+        void return_void() const noexcept {
+        }
+        void unhandled_exception() const noexcept {
+            std::terminate();
+        }
+    };
+};
+
+template<class Subscriber>
+void deliver_task(task_promise<void>&, const Subscriber&) {
+}
+template<class T, class Subscriber>
+void deliver_task(task_promise<T>& p, const Subscriber& s) {
+    s.on_next(std::move(*p.value));
+}
+
+template<class T, class Subscriber>
+detached_task run_task(task<T> t, Subscriber s) {
+    if (!s.is_subscribed()) {co_return;}
+    auto& p = co_await t.settle();
+    if (!s.is_subscribed()) {co_return;}
+    if (!!p.error) {
+        s.on_error(p.error);
+        co_return;
+    }
+    deliver_task(p, s);
+    s.on_completed();
+}
+
+template<class Factory>
+struct from_task_subscribe
+{
+    using task_type = rxu::decay_t<decltype((*(Factory*)nullptr)())>;
+    using value_type = typename std::conditional<
+        std::is_same<typename task_type::value_type, void>::value,
+        void_result, typename task_type::value_type>::type;
+
+    template<class Subscriber>
+    void operator()(Subscriber s) const {
+        run_task(factory(), std::move(s));
+    }
+
+    Factory factory;
+};
+
+}
+
+/*! \brief an observable that starts a fresh task from the factory for each subscription.
+
+    a task<T> emits its result and completes, a task<void> only completes.
+*/
+template<class Factory,
+    class Subscribe = detail::from_task_subscribe<rxu::decay_t<Factory>>>
+auto from_task(Factory&& f)
+    ->      decltype(rxs::create<typename Subscribe::value_type>(Subscribe{std::forward<Factory>(f)})) {
+    return  rxs::create<typename Subscribe::value_type>(Subscribe{std::forward<Factory>(f)});
+}
+
+}
+}
+
+namespace rxcpp {
+namespace schedulers {
+
+inline rxcpp::coroutine::resume_on_awaiter operator co_await(const scheduler& sc) {
+    return rxcpp::coroutine::resume_on(sc);
+}
+
+inline rxcpp::coroutine::resume_on_awaiter operator co_await(const run_loop& rl) {
+    return rxcpp::coroutine::resume_on(rl);
+}
+
+}
+}
+
+namespace std
+{
+
+template<typename T, typename SourceOperator>
+auto begin(const rxcpp::observable<T, SourceOperator>& o)
+    ->      rxcpp::coroutine::co_observable_iterator_awaiter<rxcpp::observable<T, SourceOperator>> {
+    return  rxcpp::coroutine::co_observable_iterator_awaiter<rxcpp::observable<T, SourceOperator>>{o};
+}
+
+template<typename T, typename SourceOperator>
+auto end(const rxcpp::observable<T, SourceOperator>&)
+    ->      rxcpp::coroutine::co_observable_iterator<rxcpp::observable<T, SourceOperator>> {
+    return  rxcpp::coroutine::co_observable_iterator<rxcpp::observable<T, SourceOperator>>{};
+}
+
+}
+
+#elif defined(_RESUMABLE_FUNCTIONS_SUPPORTED)
 
 #include <rxcpp/operators/rx-finally.hpp>
 
@@ -0,0 +1,993 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-flowable.hpp
+
+    \brief Flow controlled observables. The subscriber asks for the number of items it is ready to take with request(n)
+           and the producer never sends more than that.
+
+    A flowable hands each subscriber a flow_subscription in on_subscribe. Nothing
+    is sent until the subscriber calls request(n), and at most the sum of the
+    requests is sent. cancel() stops the producer. The operators here keep a fixed
+    amount of items in flight, so a fast producer waits for a slow consumer instead
+    of growing a queue.
+
+    auto f = rxcpp::flowables::range(1, 1000000)
+        .observe_on(rxcpp::observe_on_event_loop(), 128)
+        .buffer(16);
+    f.as_observable(64).subscribe(...);
+
+    rxcpp::flowables::from_observable(o, 256, rxcpp::overflow_policy::block) bounds a push
+    observable and flowable::as_observable(batch) turns a flowable back into one.
+
+    This header is not part of rx.hpp, it must be included explicitly.
+*/
+
+#if !defined(RXCPP_RX_FLOWABLE_HPP)
+#define RXCPP_RX_FLOWABLE_HPP
+
+#include "rx-includes.hpp"
+#include "operators/rx-observe_on.hpp"
+
+namespace rxcpp {
+
+namespace flowables {
+
+/// request(unbounded_demand) turns off flow control.
+const std::size_t unbounded_demand = (std::numeric_limits<std::size_t>::max)();
+
+inline std::size_t add_demand(std::size_t requested, std::size_t n) {
+    return requested > unbounded_demand - n ? unbounded_demand : requested + n;
+}
+
+struct flow_subscription_interface
+{
+    virtual ~flow_subscription_interface() {}
+    virtual void request(std::size_t n) = 0;
+    virtual void cancel() = 0;
+};
+
+/// the handle a subscriber uses to ask the producer for more items.
+class flow_subscription
+{
+    std::shared_ptr<flow_subscription_interface> inner;
+public:
+    flow_subscription()
+    {
+    }
+    explicit flow_subscription(std::shared_ptr<flow_subscription_interface> i)
+        : inner(std::move(i))
+    {
+    }
+    void request(std::size_t n) const {
+        if (inner && n > 0) {
+            inner->request(n);
+        }
+    }
+    void cancel() const {
+        if (inner) {
+            inner->cancel();
+        }
+    }
+};
+
+template<class T>
+struct flow_observer_interface
+{
+    virtual ~flow_observer_interface() {}
+    virtual void on_subscribe(flow_subscription s) = 0;
+    virtual void on_next(T v) = 0;
+    virtual void on_error(rxu::error_ptr e) = 0;
+    virtual void on_completed() = 0;
+};
+
+/// the consumer side of a flowable. on_subscribe is called once before any other call.
+template<class T>
+class flow_subscriber
+{
+    std::shared_ptr<flow_observer_interface<T>> inner;
+public:
+    typedef T value_type;
+
+    flow_subscriber()
+    {
+    }
+    explicit flow_subscriber(std::shared_ptr<flow_observer_interface<T>> i)
+        : inner(std::move(i))
+    {
+    }
+    void on_subscribe(flow_subscription s) const {
+        if (inner) {
+            inner->on_subscribe(std::move(s));
+        }
+    }
+    void on_next(T v) const {
+        if (inner) {
+            inner->on_next(std::move(v));
+        }
+    }
+    void on_error(rxu::error_ptr e) const {
+        if (inner) {
+            inner->on_error(e);
+        }
+    }
+    void on_completed() const {
+        if (inner) {
+            inner->on_completed();
+        }
+    }
+};
+
+namespace detail {
+
+template<class T, class OnSubscribe, class OnNext, class OnError, class OnCompleted>
+struct lambda_flow_observer : public flow_observer_interface<T>
+{
+    lambda_flow_observer(OnSubscribe s, OnNext n, OnError e, OnCompleted c)
+        : onsubscribe(std::move(s))
+        , onnext(std::move(n))
+        , onerror(std::move(e))
+        , oncompleted(std::move(c))
+    {
+    }
+    void on_subscribe(flow_subscription s) override {
+        onsubscribe(std::move(s));
+    }
+    void on_next(T v) override {
+        onnext(std::move(v));
+    }
+    void on_error(rxu::error_ptr e) override {
+        onerror(e);
+    }
+    void on_completed() override {
+        oncompleted();
+    }
+    OnSubscribe onsubscribe;
+    OnNext onnext;
+    OnError onerror;
+    OnCompleted oncompleted;
+};
+
+}
+
+template<class T, class OnSubscribe, class OnNext, class OnError = rxcpp::detail::OnErrorEmpty, class OnCompleted = rxcpp::detail::OnCompletedEmpty>
+flow_subscriber<T> make_flow_subscriber(OnSubscribe s, OnNext n, OnError e = OnError(), OnCompleted c = OnCompleted()) {
+    typedef detail::lambda_flow_observer<T, rxu::decay_t<OnSubscribe>, rxu::decay_t<OnNext>, rxu::decay_t<OnError>, rxu::decay_t<OnCompleted>> observer_type;
+    return flow_subscriber<T>(std::make_shared<observer_type>(std::move(s), std::move(n), std::move(e), std::move(c)));
+}
+
+template<class T>
+class flowable;
+
+namespace detail {
+
+// emits the values of next(rxu::maybe<T>&) while there is demand, next returns false when it is done.
+template<class T, class Next>
+struct generator : public flow_subscription_interface
+{
+    generator(flow_subscriber<T> d, Next n)
+        : dest(std::move(d))
+        , next(std::move(n))
+        , requested(0)
+        , emitting(false)
+        , stopped(false)
+    {
+    }
+    void request(std::size_t n) override {
+        std::unique_lock<std::mutex> guard(lock);
+        requested = add_demand(requested, n);
+        if (emitting) {
+            return;
+        }
+        emitting = true;
+        while (!stopped && requested > 0) {
+            rxu::maybe<T> value;
+            auto more = on_exception(
+                [&](){ return next(value); },
+                [&](rxu::error_ptr e){
+                    stopped = true;
+                    auto d = std::move(dest);
+                    guard.unlock();
+                    d.on_error(e);
+                    guard.lock();
+                });
+            if (stopped) {
+                break;
+            }
+            if (!more.get()) {
+                stopped = true;
+                auto d = std::move(dest);
+                guard.unlock();
+                d.on_completed();
+                guard.lock();
+                break;
+            }
+            if (requested != unbounded_demand) {
+                --requested;
+            }
+            guard.unlock();
+            dest.on_next(std::move(*value));
+            guard.lock();
+        }
+        emitting = false;
+    }
+    void cancel() override {
+        std::unique_lock<std::mutex> guard(lock);
+        stopped = true;
+        if (!emitting) {
+            dest = flow_subscriber<T>();
+        }
+    }
+
+    std::mutex lock;
+    flow_subscriber<T> dest;
+    Next next;
+    std::size_t requested;
+    bool emitting;
+    bool stopped;
+};
+
+template<class T, class Next>
+flowable<T> make_generator(Next n) {
+    return flowable<T>([n](flow_subscriber<T> dest){
+        auto g = std::make_shared<generator<T, Next>>(dest, n);
+        dest.on_subscribe(flow_subscription(g));
+    });
+}
+
+struct no_tag {};
+
+// a queue between producers and one subscriber that is drained while there is
+// demand. signal starts a drain, on the calling thread or on a worker, and the
+// drain runs on one thread at a time. consumed is told the tag of each item
+// that was emitted so that the producer of the item can be asked for more.
+template<class T, class Tag = no_tag>
+struct emitter : public flow_subscription_interface
+{
+    typedef std::pair<Tag, T> item_type;
+
+    explicit emitter(flow_subscriber<T> d)
+        : dest(std::move(d))
+        , requested(0)
+        , emitting(false)
+        , done(false)
+        , failed(false)
+        , terminated(false)
+        , cancelled(false)
+    {
+    }
+
+    void push(Tag tag, T v) {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            if (cancelled || done) {
+                return;
+            }
+            queue.emplace_back(std::move(tag), std::move(v));
+        }
+        signal();
+    }
+    // returns false when the queue overflowed and the emitter failed.
+    bool offer(Tag tag, T v, std::size_t capacity, overflow_policy policy) {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            if (cancelled || done) {
+                return true;
+            }
+            if (queue.size() >= capacity) {
+                switch (policy) {
+                case overflow_policy::block:
+                    if (emitting && drain_thread == std::this_thread::get_id()) {
+                        // the item comes from inside on_next of this emitter,
+                        // only this thread could make room, so waiting would
+                        // never end.
+                        guard.unlock();
+                        fail(rxu::make_static_error_ptr<queue_overflow_error>("flowable queue is full and blocking would deadlock the consumer"));
+                        return false;
+                    }
+                    space.wait(guard, [&](){ return cancelled || done || queue.size() < capacity; });
+                    if (cancelled || done) {
+                        return true;
+                    }
+                    break;
+                case overflow_policy::drop_newest:
+                    return true;
+                case overflow_policy::drop_oldest:
+                    queue.pop_front();
+                    break;
+                case overflow_policy::keep_latest:
+                    queue.pop_back();
+                    break;
+                case overflow_policy::error:
+                    guard.unlock();
+                    fail(rxu::make_static_error_ptr<queue_overflow_error>("flowable queue is full"));
+                    return false;
+                }
+            }
+            queue.emplace_back(std::move(tag), std::move(v));
+        }
+        signal();
+        return true;
+    }
+    void complete() {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            if (done) {
+                return;
+            }
+            done = true;
+        }
+        signal();
+    }
+    void fail(rxu::error_ptr e) {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            if (done) {
+                return;
+            }
+            done = true;
+            failed = true;
+            error = e;
+            queue.clear();
+            space.notify_all();
+        }
+        signal();
+        if (on_cancel) {
+            on_cancel();
+        }
+    }
+
+    void request(std::size_t n) override {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            requested = add_demand(requested, n);
+        }
+        signal();
+    }
+    void cancel() override {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            if (cancelled) {
+                return;
+            }
+            cancelled = true;
+            queue.clear();
+            space.notify_all();
+        }
+        signal();
+        if (on_cancel) {
+            on_cancel();
+        }
+    }
+
+    void drain() {
+        std::unique_lock<std::mutex> guard(lock);
+        if (emitting) {
+            return;
+        }
+        emitting = true;
+        drain_thread = std::this_thread::get_id();
+        while (!cancelled && !terminated) {
+            if (failed) {
+                terminated = true;
+                auto d = std::move(dest);
+                guard.unlock();
+                d.on_error(error);
+                guard.lock();
+                break;
+            }
+            if (!queue.empty() && requested > 0) {
+                auto item = std::move(queue.front());
+                queue.pop_front();
+                if (requested != unbounded_demand) {
+                    --requested;
+                }
+                space.notify_one();
+                guard.unlock();
+                dest.on_next(std::move(item.second));
+                if (consumed) {
+                    consumed(item.first);
+                }
+                guard.lock();
+                continue;
+            }
+            if (queue.empty() && done) {
+                terminated = true;
+                auto d = std::move(dest);
+                guard.unlock();
+                d.on_completed();
+                guard.lock();
+            }
+            break;
+        }
+        if (cancelled && !terminated) {
+            // let go of the subscriber, it may hold this emitter.
+            terminated = true;
+            auto d = std::move(dest);
+            emitting = false;
+            guard.unlock();
+            return;
+        }
+        emitting = false;
+    }
+
+    bool is_terminated() {
+        std::unique_lock<std::mutex> guard(lock);
+        return terminated;
+    }
+
+    flow_subscriber<T> dest;
+    std::function<void()> signal;
+    std::function<void(Tag&)> consumed;
+    std::function<void()> on_cancel;
+
+    std::mutex lock;
+    std::condition_variable space;
+    std::deque<item_type> queue;
+    std::size_t requested;
+    bool emitting;
+    std::thread::id drain_thread;
+    bool done;
+    bool failed;
+    bool terminated;
+    bool cancelled;
+    rxu::error_ptr error;
+};
+
+template<class T, class Tag>
+void drain_inline(const std::shared_ptr<emitter<T, Tag>>& e) {
+    std::weak_ptr<emitter<T, Tag>> weak = e;
+    e->signal = [weak](){
+        if (auto e = weak.lock()) {
+            e->drain();
+        }
+    };
+}
+
+template<class T, class Selector>
+struct map_observer : public flow_observer_interface<T>
+{
+    typedef rxu::decay_t<decltype((*(Selector*)nullptr)(*(T*)nullptr))> result_type;
+
+    map_observer(flow_subscriber<result_type> d, Selector s)
+        : dest(std::move(d))
+        , selector(std::move(s))
+        , stopped(false)
+    {
+    }
+    void on_subscribe(flow_subscription s) override {
+        upstream = s;
+        dest.on_subscribe(std::move(s));
+    }
+    void on_next(T v) override {
+        if (stopped) {
+            return;
+        }
+        auto r = on_exception(
+            [&](){ return selector(std::move(v)); },
+            [&](rxu::error_ptr e){
+                stopped = true;
+                upstream.cancel();
+                dest.on_error(e);
+            });
+        if (!r.empty()) {
+            dest.on_next(std::move(r.get()));
+        }
+    }
+    void on_error(rxu::error_ptr e) override {
+        if (!stopped) {
+            dest.on_error(e);
+        }
+    }
+    void on_completed() override {
+        if (!stopped) {
+            dest.on_completed();
+        }
+    }
+    flow_subscriber<result_type> dest;
+    Selector selector;
+    flow_subscription upstream;
+    bool stopped;
+};
+
+// asks upstream for count items for each buffer that is requested.
+template<class T>
+struct buffer_observer : public flow_observer_interface<T>, public flow_subscription_interface
+{
+    buffer_observer(flow_subscriber<std::vector<T>> d, std::size_t c)
+        : dest(std::move(d))
+        , count(c)
+    {
+        chunk.reserve(count);
+    }
+    void on_subscribe(flow_subscription s) override {
+        upstream = std::move(s);
+        dest.on_subscribe(flow_subscription(std::shared_ptr<flow_subscription_interface>(self.lock(), this)));
+    }
+    void on_next(T v) override {
+        chunk.push_back(std::move(v));
+        if (chunk.size() == count) {
+            std::vector<T> full;
+            full.reserve(count);
+            std::swap(full, chunk);
+            dest.on_next(std::move(full));
+        }
+    }
+    void on_error(rxu::error_ptr e) override {
+        dest.on_error(e);
+    }
+    void on_completed() override {
+        if (!chunk.empty()) {
+            dest.on_next(std::move(chunk));
+        }
+        dest.on_completed();
+    }
+    void request(std::size_t n) override {
+        upstream.request(n > unbounded_demand / count ? unbounded_demand : n * count);
+    }
+    void cancel() override {
+        upstream.cancel();
+    }
+    flow_subscriber<std::vector<T>> dest;
+    std::size_t count;
+    std::vector<T> chunk;
+    flow_subscription upstream;
+    std::weak_ptr<flow_observer_interface<T>> self;
+};
+
+// keeps up to prefetch items from upstream and emits them on the worker of the coordination.
+template<class T, class Coordination>
+struct observe_on_state
+{
+    typedef typename Coordination::coordinator_type coordinator_type;
+
+    observe_on_state(const Coordination& cn, std::size_t p)
+        : coordinator(cn.create_coordinator(lifetime))
+        , worker(coordinator.get_worker())
+        , prefetch(p)
+        , limit(p - p / 4)
+        , consumed(0)
+        , scheduled(false)
+    {
+    }
+    composite_subscription lifetime;
+    coordinator_type coordinator;
+    rxsc::worker worker;
+    std::shared_ptr<emitter<T>> out;
+    flow_subscription upstream;
+    std::size_t prefetch;
+    std::size_t limit;
+    std::size_t consumed;
+    std::atomic<bool> scheduled;
+};
+
+// keeps the state alive for as long as the downstream holds the subscription.
+template<class T, class Coordination>
+struct observe_on_subscription : public flow_subscription_interface
+{
+    explicit observe_on_subscription(std::shared_ptr<observe_on_state<T, Coordination>> s)
+        : state(std::move(s))
+    {
+    }
+    void request(std::size_t n) override {
+        state->out->request(n);
+    }
+    void cancel() override {
+        state->out->cancel();
+    }
+    std::shared_ptr<observe_on_state<T, Coordination>> state;
+};
+
+template<class T, class Coordination>
+flowable<T> make_observe_on(flowable<T> source, Coordination cn, std::size_t prefetch) {
+    return flowable<T>([source, cn, prefetch](flow_subscriber<T> dest){
+        typedef observe_on_state<T, Coordination> state_type;
+        auto state = std::make_shared<state_type>(cn, prefetch);
+        state->out = std::make_shared<emitter<T>>(dest);
+
+        // the queued drain holds the state, signal only needs it while the
+        // source or the downstream subscription holds it too.
+        std::weak_ptr<state_type> weak = state;
+        state->out->signal = [weak](){
+            auto state = weak.lock();
+            if (!state || state->scheduled.exchange(true)) {
+                return;
+            }
+            auto drain = [state](const rxsc::schedulable&){
+                state->scheduled = false;
+                state->out->drain();
+                if (state->out->is_terminated()) {
+                    state->lifetime.unsubscribe();
+                }
+            };
+            auto selectedDrain = on_exception(
+                [&](){ return state->coordinator.act(drain); },
+                [&](rxu::error_ptr e){ state->out->fail(e); });
+            if (selectedDrain.empty()) {
+                return;
+            }
+            state->worker.schedule(selectedDrain.get());
+        };
+        // the drain runs on the worker while the work holds the state
+        auto raw = state.get();
+        state->out->consumed = [raw](no_tag&){
+            if (++raw->consumed == raw->limit) {
+                raw->consumed = 0;
+                raw->upstream.request(raw->limit);
+            }
+        };
+        state->out->on_cancel = [weak](){
+            if (auto state = weak.lock()) {
+                state->upstream.cancel();
+                state->lifetime.unsubscribe();
+            }
+        };
+
+        dest.on_subscribe(flow_subscription(std::make_shared<observe_on_subscription<T, Coordination>>(state)));
+        source.subscribe(make_flow_subscriber<T>(
+            [state](flow_subscription s){
+                state->upstream = s;
+                s.request(state->prefetch);
+            },
+            [state](T v){
+                state->out->push(no_tag(), std::move(v));
+            },
+            [state](rxu::error_ptr e){
+                state->out->fail(e);
+            },
+            [state](){
+                state->out->complete();
+            }));
+    });
+}
+
+// subscribes to at most max_concurrent inner flowables at once and keeps up to
+// prefetch items from each of them.
+template<class R>
+struct flat_map_state
+{
+    struct inner_state
+    {
+        explicit inner_state(std::size_t l)
+            : limit(l)
+            , consumed(0)
+        {
+        }
+        flow_subscription upstream;
+        std::size_t limit;
+        // only touched by the thread that drains
+        std::size_t consumed;
+    };
+    typedef std::shared_ptr<inner_state> inner_type;
+
+    flat_map_state(std::size_t mc, std::size_t p)
+        : max_concurrent(mc)
+        , prefetch(p)
+        , limit(p - p / 4)
+        , active(0)
+        , outer_done(false)
+    {
+    }
+
+    void finish_inner(const inner_type& inner) {
+        bool complete = false;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            inners.erase(inner);
+            --active;
+            complete = outer_done && active == 0;
+        }
+        if (complete) {
+            out->complete();
+        } else {
+            outer.request(1);
+        }
+    }
+    void cancel_all() {
+        std::set<inner_type> expired;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            std::swap(expired, inners);
+        }
+        outer.cancel();
+        for (auto& inner : expired) {
+            inner->upstream.cancel();
+        }
+    }
+
+    std::shared_ptr<emitter<R, inner_type>> out;
+    flow_subscription outer;
+    std::size_t max_concurrent;
+    std::size_t prefetch;
+    std::size_t limit;
+
+    std::mutex lock;
+    std::set<inner_type> inners;
+    std::size_t active;
+    bool outer_done;
+};
+
+template<class T, class Selector>
+auto make_flat_map(flowable<T> source, Selector selector, std::size_t max_concurrent, std::size_t prefetch)
+    -> flowable<typename rxu::decay_t<decltype(selector(*(T*)nullptr))>::value_type> {
+    typedef typename rxu::decay_t<decltype(selector(*(T*)nullptr))>::value_type result_type;
+    typedef flat_map_state<result_type> state_type;
+    typedef typename state_type::inner_type inner_type;
+
+    return flowable<result_type>([source, selector, max_concurrent, prefetch](flow_subscriber<result_type> dest){
+        auto state = std::make_shared<state_type>(max_concurrent, prefetch);
+        state->out = std::make_shared<emitter<result_type, inner_type>>(dest);
+        drain_inline(state->out);
+        state->out->consumed = [](inner_type& inner){
+            if (++inner->consumed == inner->limit) {
+                inner->consumed = 0;
+                inner->upstream.request(inner->limit);
+            }
+        };
+        std::weak_ptr<state_type> weak = state;
+        state->out->on_cancel = [weak](){
+            if (auto state = weak.lock()) {
+                state->cancel_all();
+            }
+        };
+
+        dest.on_subscribe(flow_subscription(state->out));
+        source.subscribe(make_flow_subscriber<T>(
+            [state](flow_subscription s){
+                state->outer = s;
+                s.request(state->max_concurrent);
+            },
+            [state, selector](T v){
+                auto inner_source = on_exception(
+                    [&](){ return selector(std::move(v)); },
+                    [&](rxu::error_ptr e){ state->out->fail(e); });
+                if (inner_source.empty()) {
+                    return;
+                }
+                auto inner = std::make_shared<typename state_type::inner_state>(state->limit);
+                {
+                    std::unique_lock<std::mutex> guard(state->lock);
+                    state->inners.insert(inner);
+                    ++state->active;
+                }
+                inner_source.get().subscribe(make_flow_subscriber<result_type>(
+                    [state, inner](flow_subscription s){
+                        inner->upstream = s;
+                        s.request(state->prefetch);
+                    },
+                    [state, inner](result_type r){
+                        state->out->push(inner, std::move(r));
+                    },
+                    [state](rxu::error_ptr e){
+                        state->out->fail(e);
+                    },
+                    [state, inner](){
+                        state->finish_inner(inner);
+                    }));
+            },
+            [state](rxu::error_ptr e){
+                state->out->fail(e);
+            },
+            [state](){
+                bool complete = false;
+                {
+                    std::unique_lock<std::mutex> guard(state->lock);
+                    state->outer_done = true;
+                    complete = state->active == 0;
+                }
+                if (complete) {
+                    state->out->complete();
+                }
+            }));
+    });
+}
+
+template<class T>
+observable<T> make_as_observable(flowable<T> source, std::size_t batch) {
+    return observable<>::create<T>([source, batch](subscriber<T> s){
+        struct state_type
+        {
+            flow_subscription upstream;
+            std::size_t limit;
+            std::size_t consumed;
+        };
+        auto state = std::make_shared<state_type>();
+        state->limit = batch - batch / 4;
+        state->consumed = 0;
+        source.subscribe(make_flow_subscriber<T>(
+            [state, s, batch](flow_subscription u){
+                state->upstream = u;
+                s.add([u](){ u.cancel(); });
+                u.request(batch);
+            },
+            [state, s](T v){
+                s.on_next(std::move(v));
+                if (++state->consumed == state->limit) {
+                    state->consumed = 0;
+                    state->upstream.request(state->limit);
+                }
+            },
+            [s](rxu::error_ptr e){
+                s.on_error(e);
+            },
+            [s](){
+                s.on_completed();
+            }));
+    });
+}
+
+}
+
+/*!
+    \brief a source of items that waits for its subscriber to request them.
+
+    \ingroup group-observable
+*/
+template<class T>
+class flowable
+{
+public:
+    typedef T value_type;
+    typedef std::function<void(flow_subscriber<T>)> on_subscribe_type;
+
+    explicit flowable(on_subscribe_type os)
+        : on_subscribe(std::move(os))
+    {
+    }
+
+    void subscribe(flow_subscriber<T> s) const {
+        on_subscribe(std::move(s));
+    }
+
+    /// transform each item on the thread that emits it.
+    template<class Selector>
+    auto map(Selector s) const
+        -> flowable<typename detail::map_observer<T, rxu::decay_t<Selector>>::result_type> {
+        typedef detail::map_observer<T, rxu::decay_t<Selector>> observer_type;
+        typedef typename observer_type::result_type result_type;
+        auto source = *this;
+        return flowable<result_type>([source, s](flow_subscriber<result_type> dest){
+            source.subscribe(flow_subscriber<T>(std::make_shared<observer_type>(std::move(dest), s)));
+        });
+    }
+
+    /// group the items in vectors of count, the last one may be shorter.
+    flowable<std::vector<T>> buffer(std::size_t count) const {
+        if (count == 0) {
+            std::terminate();
+        }
+        auto source = *this;
+        return flowable<std::vector<T>>([source, count](flow_subscriber<std::vector<T>> dest){
+            auto o = std::make_shared<detail::buffer_observer<T>>(std::move(dest), count);
+            o->self = o;
+            source.subscribe(flow_subscriber<T>(o));
+        });
+    }
+
+    /// emit on the worker of the coordination, with at most prefetch items waiting.
+    template<class Coordination>
+    flowable<T> observe_on(Coordination cn, std::size_t prefetch = 128) const {
+        static_assert(is_coordination<Coordination>::value, "observe_on takes (Coordination, optional Prefetch)");
+        if (prefetch == 0) {
+            std::terminate();
+        }
+        return detail::make_observe_on(*this, std::move(cn), prefetch);
+    }
+
+    /// merge the flowables that selector returns, subscribed to at most max_concurrent at once
+    /// and with at most prefetch items waiting from each.
+    template<class Selector>
+    auto flat_map(Selector s, std::size_t max_concurrent, std::size_t prefetch = 32) const
+        -> decltype(detail::make_flat_map(*(flowable<T>*)nullptr, std::move(s), max_concurrent, prefetch)) {
+        if (max_concurrent == 0 || prefetch == 0) {
+            std::terminate();
+        }
+        return detail::make_flat_map(*this, std::move(s), max_concurrent, prefetch);
+    }
+
+    /// for a flowable of flowables, merge at most max_concurrent of them at once.
+    template<class U = T>
+    auto merge(std::size_t max_concurrent) const
+        -> decltype(std::declval<flowable<U>>().flat_map(rxu::detail::take_at<0>(), max_concurrent)) {
+        return flat_map(rxu::detail::take_at<0>(), max_concurrent);
+    }
+
+    /// a push observable that keeps up to batch items requested.
+    observable<T> as_observable(std::size_t batch = 128) const {
+        if (batch == 0) {
+            std::terminate();
+        }
+        return detail::make_as_observable(*this, batch);
+    }
+
+private:
+    on_subscribe_type on_subscribe;
+};
+
+/// the integers from first to last, inclusive.
+template<class T>
+flowable<T> range(T first, T last) {
+    auto next = first;
+    auto done = first > last;
+    return detail::make_generator<T>([next, last, done](rxu::maybe<T>& v) mutable {
+        if (done) {
+            return false;
+        }
+        v.reset(next);
+        if (next == last) {
+            done = true;
+        } else {
+            ++next;
+        }
+        return true;
+    });
+}
+
+/// the items of a copy of the collection.
+template<class Collection>
+auto iterate(Collection c)
+    -> flowable<rxu::decay_t<decltype(*std::begin(c))>> {
+    typedef rxu::decay_t<decltype(*std::begin(c))> value_type;
+    auto items = std::make_shared<Collection>(std::move(c));
+    return flowable<value_type>([items](flow_subscriber<value_type> dest){
+        auto cursor = std::begin(*items);
+        auto g = std::make_shared<detail::generator<value_type, std::function<bool(rxu::maybe<value_type>&)>>>(dest,
+            [items, cursor](rxu::maybe<value_type>& v) mutable {
+                if (cursor == std::end(*items)) {
+                    return false;
+                }
+                v.reset(*cursor++);
+                return true;
+            });
+        dest.on_subscribe(flow_subscription(g));
+    });
+}
+
+/// merge the flowables, all of them subscribed at once.
+template<class T, class... TN>
+flowable<T> merge(flowable<T> first, flowable<TN>... rest) {
+    std::vector<flowable<T>> all{first, rest...};
+    auto count = all.size();
+    return iterate(std::move(all)).merge(count);
+}
+
+/// keep up to capacity items of a push observable until they are requested,
+/// policy decides what happens to an item that arrives when the queue is full.
+/// overflow_policy::block waits for the consumer to take an item, so the request
+/// must come from another thread. an item that arrives from inside on_next of the
+/// consumer would wait forever, it fails the flowable with queue_overflow_error.
+template<class T, class SourceOperator>
+flowable<T> from_observable(observable<T, SourceOperator> o, std::size_t capacity, overflow_policy policy) {
+    if (capacity == 0) {
+        std::terminate();
+    }
+    return flowable<T>([o, capacity, policy](flow_subscriber<T> dest){
+        auto out = std::make_shared<detail::emitter<T>>(dest);
+        detail::drain_inline(out);
+        composite_subscription lifetime;
+        out->on_cancel = [lifetime](){
+            lifetime.unsubscribe();
+        };
+        dest.on_subscribe(flow_subscription(out));
+        o.subscribe(
+            lifetime,
+            [out, capacity, policy](T v){
+                out->offer(detail::no_tag(), std::move(v), capacity, policy);
+            },
+            [out](rxu::error_ptr e){
+                out->fail(e);
+            },
+            [out](){
+                out->complete();
+            });
+    });
+}
+
+}
+
+namespace rxfl=flowables;
+
+}
+
+#endif
@@ -101,6 +101,12 @@
 #define RXCPP_ON_ANDROID
 #endif
 
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define RXCPP_USE_STD_COROUTINES 1
+#endif
+#endif
+
 #if defined(RXCPP_FORCE_USE_VARIADIC_TEMPLATES)
 #undef RXCPP_USE_VARIADIC_TEMPLATES
 #define RXCPP_USE_VARIADIC_TEMPLATES RXCPP_FORCE_USE_VARIADIC_TEMPLATES
@@ -126,6 +132,11 @@
 #define RXCPP_USE_WINRT RXCPP_FORCE_USE_WINRT
 #endif
 
+#if defined(RXCPP_FORCE_USE_STD_COROUTINES)
+#undef RXCPP_USE_STD_COROUTINES
+#define RXCPP_USE_STD_COROUTINES RXCPP_FORCE_USE_STD_COROUTINES
+#endif
+
 #if defined(RXCPP_FORCE_HASH_ENUM)
 #undef RXCPP_HASH_ENUM
 #define RXCPP_HASH_ENUM RXCPP_FORCE_HASH_ENUM
@@ -165,6 +176,7 @@
 #include <stdlib.h>
 
 #include <cstddef>
+#include <cstdint>
 
 #include <string>
 
@@ -201,6 +213,8 @@
 
 #include "rx-util.hpp"
 #include "rx-predef.hpp"
+#include "rx-arena.hpp"
+#include "rx-confined.hpp"
 #include "rx-subscription.hpp"
 #include "rx-observer.hpp"
 #include "rx-scheduler.hpp"
@@ -218,9 +232,11 @@
 #include "operators/rx-all.hpp"
 #include "operators/rx-amb.hpp"
 #include "operators/rx-any.hpp"
+#include "operators/rx-audit.hpp"
 #include "operators/rx-buffer_count.hpp"
 #include "operators/rx-buffer_time.hpp"
 #include "operators/rx-buffer_time_count.hpp"
+#include "operators/rx-coalesce_until.hpp"
 #include "operators/rx-combine_latest.hpp"
 #include "operators/rx-concat.hpp"
 #include "operators/rx-concat_map.hpp"
@@ -236,11 +252,15 @@
 #include "operators/rx-group_by.hpp"
 #include "operators/rx-ignore_elements.hpp"
 #include "operators/rx-map.hpp"
+#include "operators/rx-map_parallel.hpp"
 #include "operators/rx-merge.hpp"
 #include "operators/rx-merge_delay_error.hpp"
+#include "operators/rx-multi_click.hpp"
 #include "operators/rx-observe_on.hpp"
 #include "operators/rx-on_error_resume_next.hpp"
 #include "operators/rx-pairwise.hpp"
+#include "operators/rx-partition.hpp"
+#include "operators/rx-press_gesture.hpp"
 #include "operators/rx-reduce.hpp"
 #include "operators/rx-repeat.hpp"
 #include "operators/rx-replay.hpp"
@@ -262,6 +282,8 @@
 #include "operators/rx-take_while.hpp"
 #include "operators/rx-tap.hpp"
 #include "operators/rx-throttle.hpp"
+#include "operators/rx-throttle_first.hpp"
+#include "operators/rx-throttle_last.hpp"
 #include "operators/rx-time_interval.hpp"
 #include "operators/rx-timeout.hpp"
 #include "operators/rx-timestamp.hpp"
@@ -269,6 +291,7 @@
 #include "operators/rx-window_time.hpp"
 #include "operators/rx-window_time_count.hpp"
 #include "operators/rx-window_toggle.hpp"
+#include "operators/rx-while_active.hpp"
 #include "operators/rx-with_latest_from.hpp"
 #include "operators/rx-zip.hpp"
 #endif
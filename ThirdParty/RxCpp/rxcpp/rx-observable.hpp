@@ -32,66 +32,173 @@ struct has_on_subscribe_for
 
 }
 
+namespace detail {
+
+template<class T>
+struct dynamic_observable_vtable
+{
+    void (*subscribe)(void*, subscriber<T>);
+    void (*copy)(const void*, void*);
+    void (*relocate)(void*, void*);
+    void (*destroy)(void*);
+};
+
+// Source is a source or operator, or a function that takes the subscriber.
+template<class T, class Source, bool IsFunction, std::size_t Capacity>
+struct dynamic_observable_table
+{
+    typedef std::integral_constant<bool, dynamic_fits<Source, Capacity>::value> is_inline;
+    typedef dynamic_storage<Source, is_inline::value> storage;
+    typedef dynamic_held<typename storage::held_type> held;
+
+    template<class SO>
+    static void construct(void* b, SO&& so) {
+        construct(b, std::forward<SO>(so), is_inline());
+    }
+    template<class SO>
+    static void construct(void* b, SO&& so, std::true_type) {
+        new (b) Source(std::forward<SO>(so));
+    }
+    template<class SO>
+    static void construct(void* b, SO&& so, std::false_type) {
+        new (b) std::shared_ptr<Source>(std::make_shared<Source>(std::forward<SO>(so)));
+    }
+
+    static void subscribe(void* b, subscriber<T> o) {
+        subscribe(storage::get(b), std::move(o), std::integral_constant<bool, IsFunction>());
+    }
+    static void subscribe(Source& so, subscriber<T> o, std::false_type) {
+        so.on_subscribe(std::move(o));
+    }
+    static void subscribe(Source& f, subscriber<T> o, std::true_type) {
+        f(std::move(o));
+    }
+
+    static const dynamic_observable_vtable<T> table;
+};
+
+template<class T, class Source, bool IsFunction, std::size_t Capacity>
+const dynamic_observable_vtable<T> dynamic_observable_table<T, Source, IsFunction, Capacity>::table = {
+    &dynamic_observable_table::subscribe,
+    &held::copy,
+    &held::relocate,
+    &held::destroy
+};
+
+}
+
 template<class T>
 class dynamic_observable
     : public rxs::source_base<T>
 {
-    struct state_type
-        : public std::enable_shared_from_this<state_type>
-    {
-        typedef std::function<void(subscriber<T>)> onsubscribe_type;
+public:
+    typedef tag_dynamic_observable dynamic_observable_tag;
+
+    /// a source up to this size is copied with the dynamic observable, a larger one is shared by the copies.
+    static const std::size_t inline_capacity = 6 * sizeof(void*);
+
+private:
+    typedef detail::dynamic_observable_vtable<T> vtable_type;
 
-        onsubscribe_type on_subscribe;
-    };
-    std::shared_ptr<state_type> state;
+    const vtable_type* table;
+    // copies of one dynamic_observable compare equal, the source may be
+    // copied with them so its address does not tell.
+    unsigned long id;
+    alignas(void*) mutable unsigned char storage[inline_capacity];
 
     template<class U>
     friend bool operator==(const dynamic_observable<U>&, const dynamic_observable<U>&);
 
     template<class SO>
     void construct(SO&& source, rxs::tag_source&&) {
-        rxu::decay_t<SO> so = std::forward<SO>(source);
-        state->on_subscribe = [so](subscriber<T> o) mutable {
-            so.on_subscribe(std::move(o));
-        };
+        typedef detail::dynamic_observable_table<T, rxu::decay_t<SO>, false, inline_capacity> table_type;
+        table_type::construct(storage, std::forward<SO>(source));
+        table = &table_type::table;
     }
 
     struct tag_function {};
     template<class F>
     void construct(F&& f, tag_function&&) {
-        state->on_subscribe = std::forward<F>(f);
+        typedef detail::dynamic_observable_table<T, rxu::decay_t<F>, true, inline_capacity> table_type;
+        table_type::construct(storage, std::forward<F>(f));
+        table = &table_type::table;
     }
 
 public:
 
-    typedef tag_dynamic_observable dynamic_observable_tag;
-
     dynamic_observable()
+        : table(nullptr)
+        , id(0)
+    {
+    }
+    dynamic_observable(const dynamic_observable& o)
+        : rxs::source_base<T>(o)
+        , table(nullptr)
+        , id(o.id)
     {
+        if (o.table) {
+            o.table->copy(o.storage, storage);
+            table = o.table;
+        }
+    }
+    dynamic_observable(dynamic_observable&& o)
+        : rxs::source_base<T>(std::move(o))
+        , table(nullptr)
+        , id(o.id)
+    {
+        if (o.table) {
+            o.table->relocate(o.storage, storage);
+            table = o.table;
+            o.table = nullptr;
+            o.id = 0;
+        }
     }
 
     template<class SOF>
     explicit dynamic_observable(SOF&& sof, typename std::enable_if<!is_dynamic_observable<SOF>::value, void**>::type = 0)
-        : state(std::make_shared<state_type>())
+        : table(nullptr)
+        // any unique id will do, subscribers take theirs from the same counter
+        , id(trace_id::make_next_id_subscriber().id)
     {
         construct(std::forward<SOF>(sof),
                   typename std::conditional<rxs::is_source<SOF>::value || rxo::is_operator<SOF>::value, rxs::tag_source, tag_function>::type());
     }
 
+    ~dynamic_observable()
+    {
+        if (table) {
+            table->destroy(storage);
+        }
+    }
+
+    dynamic_observable& operator=(dynamic_observable o) {
+        if (table) {
+            table->destroy(storage);
+            table = nullptr;
+        }
+        id = o.id;
+        if (o.table) {
+            o.table->relocate(o.storage, storage);
+            table = o.table;
+            o.table = nullptr;
+        }
+        return *this;
+    }
+
     void on_subscribe(subscriber<T> o) const {
-        state->on_subscribe(std::move(o));
+        table->subscribe(storage, std::move(o));
     }
 
     template<class Subscriber>
     typename std::enable_if<is_subscriber<Subscriber>::value, void>::type
     on_subscribe(Subscriber o) const {
-        state->on_subscribe(o.as_dynamic());
+        table->subscribe(storage, o.as_dynamic());
     }
 };
 
 template<class T>
 inline bool operator==(const dynamic_observable<T>& lhs, const dynamic_observable<T>& rhs) {
-    return lhs.state == rhs.state;
+    return lhs.id == rhs.id;
 }
 template<class T>
 inline bool operator!=(const dynamic_observable<T>& lhs, const dynamic_observable<T>& rhs) {
@@ -650,6 +757,14 @@ public:
         return detail_subscribe(make_subscriber<T>(std::forward<ArgN>(an)...));
     }
 
+    /// subscribe with the states of the chain allocated from arena, see rx-arena.hpp.
+    template<class... ArgN>
+    auto subscribe(subscription_arena& arena, ArgN&&... an) const
+        -> composite_subscription {
+        arena_scope scope(arena);
+        return detail_subscribe(make_subscriber<T>(std::forward<ArgN>(an)...));
+    }
+
     /*! @copydoc rx-all.hpp
      */
     template<class... AN>
@@ -760,6 +875,17 @@ public:
         return      observable_member(tap_tag{},                *this, std::forward<AN>(an)...);
     }
 
+    /*! @copydoc rx-record_to.hpp
+     */
+    template<class... AN>
+    auto record_to(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(record_to_tag{}, *(this_type*)nullptr, std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(record_to_tag{},                *this, std::forward<AN>(an)...);
+    }
+
     /*! @copydoc rx-time_interval.hpp
      */
     template<class... AN>
@@ -848,6 +974,17 @@ public:
         return  observable_member(map_tag{},                *this, std::forward<AN>(an)...);
     }
 
+    /*! @copydoc rx-map_parallel.hpp
+     */
+    template<class... AN>
+    auto map_parallel(AN&&... an) const
+    /// \cond SHOW_SERVICE_MEMBERS
+    -> decltype(observable_member(map_parallel_tag{}, *(this_type*)nullptr, std::forward<AN>(an)...))
+    /// \endcond
+    {
+        return  observable_member(map_parallel_tag{},                *this, std::forward<AN>(an)...);
+    }
+
     /*! @copydoc rx-debounce.hpp
      */
     template<class... AN>
@@ -1124,6 +1261,17 @@ public:
         return      observable_member(group_by_tag{},                *this, std::forward<AN>(an)...);
     }
 
+    /*! @copydoc rx-partition.hpp
+     */
+    template<class... AN>
+    inline auto partition(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(partition_tag{}, *(this_type*)nullptr, std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(partition_tag{},                *this, std::forward<AN>(an)...);
+    }
+
     /*! @copydoc rx-ignore_elements.hpp
      */
     template<class... AN>
@@ -1406,6 +1554,28 @@ public:
         return      observable_member(take_until_tag{},                *this, std::forward<AN>(an)...);
     }
 
+    /*! @copydoc rx-coalesce_until.hpp
+    */
+    template<class... AN>
+    auto coalesce_until(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(coalesce_until_tag{}, *(this_type*)nullptr, std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(coalesce_until_tag{},                *this, std::forward<AN>(an)...);
+    }
+
+    /*! @copydoc rx-while_active.hpp
+    */
+    template<class... AN>
+    auto while_active(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(while_active_tag{}, *(this_type*)nullptr, std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(while_active_tag{},                *this, std::forward<AN>(an)...);
+    }
+
     /*! @copydoc rx-take_while.hpp
     */
     template<class... AN>
@@ -1428,6 +1598,61 @@ public:
         return      observable_member(throttle_tag{}, *this, std::forward<AN>(an)...);
     }
 
+    /*! @copydoc rx-throttle_first.hpp
+    */
+    template<class... AN>
+    auto throttle_first(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(throttle_first_tag{}, *(this_type*)nullptr, std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(throttle_first_tag{},                *this, std::forward<AN>(an)...);
+    }
+
+    /*! @copydoc rx-throttle_last.hpp
+    */
+    template<class... AN>
+    auto throttle_last(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(throttle_last_tag{}, *(this_type*)nullptr, std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(throttle_last_tag{},                *this, std::forward<AN>(an)...);
+    }
+
+    /*! @copydoc rx-audit.hpp
+    */
+    template<class... AN>
+    auto audit(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(audit_tag{}, *(this_type*)nullptr, std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(audit_tag{},                *this, std::forward<AN>(an)...);
+    }
+
+    /*! @copydoc rx-multi_click.hpp
+    */
+    template<class... AN>
+    auto multi_click(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(multi_click_tag{}, *(this_type*)nullptr, std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(multi_click_tag{},                *this, std::forward<AN>(an)...);
+    }
+
+    /*! @copydoc rx-press_gesture.hpp
+    */
+    template<class... AN>
+    auto press_gesture(AN&&... an) const
+        /// \cond SHOW_SERVICE_MEMBERS
+        -> decltype(observable_member(press_gesture_tag{}, *(this_type*)nullptr, std::forward<AN>(an)...))
+        /// \endcond
+    {
+        return      observable_member(press_gesture_tag{},                *this, std::forward<AN>(an)...);
+    }
+
     /*! @copydoc rx-repeat.hpp
      */
     template<class... AN>
@@ -344,43 +344,114 @@ public:
 namespace detail
 {
 
+// the storage of a type-forgetting observer or observable. an object that
+// fits is held in the buffer and copied with it, a larger one is allocated
+// once and the copies share it through a shared_ptr held in the buffer.
+template<class Stored, std::size_t Capacity>
+struct dynamic_fits
+{
+    static const bool value = sizeof(Stored) <= Capacity &&
+        std::alignment_of<Stored>::value <= std::alignment_of<void*>::value;
+};
+
+template<class Stored, bool Inline>
+struct dynamic_storage;
+
+template<class Stored>
+struct dynamic_storage<Stored, true>
+{
+    typedef Stored held_type;
+    static Stored& get(void* b) {
+        return *static_cast<Stored*>(b);
+    }
+};
+
+template<class Stored>
+struct dynamic_storage<Stored, false>
+{
+    typedef std::shared_ptr<Stored> held_type;
+    static Stored& get(void* b) {
+        return **static_cast<held_type*>(b);
+    }
+};
+
+template<class Held>
+struct dynamic_held
+{
+    static void copy(const void* from, void* to) {
+        new (to) Held(*static_cast<const Held*>(from));
+    }
+    // leaves from empty
+    static void relocate(void* from, void* to) {
+        auto& h = *static_cast<Held*>(from);
+        new (to) Held(std::move(h));
+        h.~Held();
+    }
+    static void destroy(void* b) {
+        static_cast<Held*>(b)->~Held();
+    }
+};
+
 template<class T>
-struct virtual_observer : public std::enable_shared_from_this<virtual_observer<T>>
+struct dynamic_observer_vtable
 {
-    virtual ~virtual_observer() {}
-    virtual void on_next(const T&) const {};
-    virtual void on_next(T&&) const {};
-    virtual void on_error(rxu::error_ptr) const {};
-    virtual void on_completed() const {};
+    void (*on_next_copy)(void*, const T&);
+    void (*on_next_move)(void*, T&&);
+    void (*on_error)(void*, rxu::error_ptr);
+    void (*on_completed)(void*);
+    void (*copy)(const void*, void*);
+    void (*relocate)(void*, void*);
+    void (*destroy)(void*);
 };
 
-template<class T, class Observer>
-struct specific_observer : public virtual_observer<T>
+template<class T, class Observer, std::size_t Capacity>
+struct dynamic_observer_table
 {
-    explicit specific_observer(Observer o)
-        : destination(std::move(o))
-    {
+    typedef std::integral_constant<bool, dynamic_fits<Observer, Capacity>::value> is_inline;
+    typedef dynamic_storage<Observer, is_inline::value> storage;
+    typedef dynamic_held<typename storage::held_type> held;
+
+    static void construct(void* b, Observer o) {
+        construct(b, std::move(o), is_inline());
+    }
+    static void construct(void* b, Observer o, std::true_type) {
+        new (b) Observer(std::move(o));
+    }
+    static void construct(void* b, Observer o, std::false_type) {
+        new (b) std::shared_ptr<Observer>(rxu::make_arena_shared<Observer>(std::move(o)));
     }
 
-    Observer destination;
-    void on_next(const T& t) const override {
-        destination.on_next(t);
+    static void on_next_copy(void* b, const T& t) {
+        storage::get(b).on_next(t);
     }
-    void on_next(T&& t) const override{
-        destination.on_next(std::move(t));
+    static void on_next_move(void* b, T&& t) {
+        storage::get(b).on_next(std::move(t));
     }
-    void on_error(rxu::error_ptr e) const override{
-        destination.on_error(e);
+    static void on_error(void* b, rxu::error_ptr e) {
+        storage::get(b).on_error(e);
     }
-    void on_completed() const override {
-        destination.on_completed();
+    static void on_completed(void* b) {
+        storage::get(b).on_completed();
     }
+
+    static const dynamic_observer_vtable<T> table;
+};
+
+template<class T, class Observer, std::size_t Capacity>
+const dynamic_observer_vtable<T> dynamic_observer_table<T, Observer, Capacity>::table = {
+    &dynamic_observer_table::on_next_copy,
+    &dynamic_observer_table::on_next_move,
+    &dynamic_observer_table::on_error,
+    &dynamic_observer_table::on_completed,
+    &held::copy,
+    &held::relocate,
+    &held::destroy
 };
 
 }
 
 /*!
-    \brief consumes values from an observable using type-forgetting (shared allocated state with virtual methods)
+    \brief consumes values from an observable using type-forgetting (the observer is stored inline, or allocated when it is larger than inline_capacity, and called through a static table of functions)
 
     \tparam T            - the type of value in the stream
 
@@ -393,58 +464,94 @@ class observer<T, void, void, void, void> : public observer_base<T>
 public:
     typedef tag_dynamic_observer dynamic_observer_tag;
 
+    /// an observer up to this size is copied with the dynamic observer, a larger one is shared by the copies.
+    static const std::size_t inline_capacity = 6 * sizeof(void*);
+
 private:
     using this_type = observer<T, void, void, void, void>;
     using base_type = observer_base<T>;
-    using virtual_observer = detail::virtual_observer<T>;
+    typedef detail::dynamic_observer_vtable<T> vtable_type;
 
-    std::shared_ptr<virtual_observer> destination;
+    const vtable_type* table;
+    alignas(void*) mutable unsigned char storage[inline_capacity];
 
-    template<class Observer>
-    static auto make_destination(Observer o)
-        -> std::shared_ptr<virtual_observer> {
-        return std::make_shared<detail::specific_observer<T, Observer>>(std::move(o));
+    // an lvalue is passed as const T&, an rvalue as T&&.
+    template<class V>
+    void next(V&& v, std::true_type) const {
+        table->on_next_copy(storage, v);
+    }
+    template<class V>
+    void next(V&& v, std::false_type) const {
+        table->on_next_move(storage, std::forward<V>(v));
     }
 
 public:
     observer()
+        : table(nullptr)
     {
     }
     observer(const this_type& o)
-        : destination(o.destination)
+        : table(nullptr)
     {
+        if (o.table) {
+            o.table->copy(o.storage, storage);
+            table = o.table;
+        }
     }
     observer(this_type&& o)
-        : destination(std::move(o.destination))
+        : table(nullptr)
     {
+        if (o.table) {
+            o.table->relocate(o.storage, storage);
+            table = o.table;
+            o.table = nullptr;
+        }
     }
 
     template<class Observer>
     explicit observer(Observer o)
-        : destination(make_destination(std::move(o)))
+        : table(nullptr)
     {
+        typedef detail::dynamic_observer_table<T, Observer, inline_capacity> table_type;
+        table_type::construct(storage, std::move(o));
+        table = &table_type::table;
+    }
+
+    ~observer()
+    {
+        if (table) {
+            table->destroy(storage);
+        }
     }
 
     this_type& operator=(this_type o) {
-        destination = std::move(o.destination);
+        if (table) {
+            table->destroy(storage);
+            table = nullptr;
+        }
+        if (o.table) {
+            o.table->relocate(o.storage, storage);
+            table = o.table;
+            o.table = nullptr;
+        }
         return *this;
     }
 
     // perfect forwarding delays the copy of the value.
     template<class V>
     void on_next(V&& v) const {
-        if (destination) {
-            destination->on_next(std::forward<V>(v));
+        if (table) {
+            next(std::forward<V>(v), std::is_lvalue_reference<V>());
         }
     }
     void on_error(rxu::error_ptr e) const {
-        if (destination) {
-            destination->on_error(e);
+        if (table) {
+            table->on_error(storage, e);
         }
     }
     void on_completed() const {
-        if (destination) {
-            destination->on_completed();
+        if (table) {
+            table->on_completed(storage);
         }
     }
 
@@ -96,6 +96,7 @@ public:
 }
 
 #include "operators/rx-lift.hpp"
+#include "operators/rx-fuse.hpp"
 #include "operators/rx-subscribe.hpp"
 
 namespace rxcpp {
@@ -126,6 +127,13 @@ struct any_tag {
 struct exists_tag : any_tag {};
 struct contains_tag : any_tag {};
 
+struct audit_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-audit.hpp>");
+    };
+};
+
 struct buffer_count_tag {
     template<class Included>
     struct include_header{
@@ -147,6 +155,13 @@ struct buffer_with_time_or_count_tag {
     };
 };
 
+struct coalesce_until_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-coalesce_until.hpp>");
+    };
+};
+
 struct combine_latest_tag {
     template<class Included>
     struct include_header{
@@ -252,6 +267,13 @@ struct map_tag {
     };
 };
 
+struct map_parallel_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-map_parallel.hpp>");
+    };
+};
+
 struct merge_tag {
     template<class Included>
     struct include_header{
@@ -272,6 +294,13 @@ struct multicast_tag {
     };
 };
 
+struct multi_click_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-multi_click.hpp>");
+    };
+};
+
 struct observe_on_tag {
     template<class Included>
     struct include_header{
@@ -293,6 +322,13 @@ class empty_error: public std::runtime_error
             std::runtime_error(msg)
         {}
 };
+struct record_to_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/rx-recorder.hpp>");
+    };
+};
+
 struct reduce_tag {
     template<class Included>
     struct include_header{
@@ -320,6 +356,20 @@ struct pairwise_tag {
     };
 };
 
+struct partition_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-partition.hpp>");
+    };
+};
+
+struct press_gesture_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-press_gesture.hpp>");
+    };
+};
+
 struct publish_tag {
     template<class Included>
     struct include_header{
@@ -469,6 +519,20 @@ struct throttle_tag {
     };
 };
 
+struct throttle_first_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-throttle_first.hpp>");
+    };
+};
+
+struct throttle_last_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-throttle_last.hpp>");
+    };
+};
+
 struct timeout_tag {
     template<class Included>
     struct include_header{
@@ -518,6 +582,13 @@ struct window_toggle_tag {
     };
 };
 
+struct while_active_tag {
+    template<class Included>
+    struct include_header{
+        static_assert(Included::value, "missing include: please #include <rxcpp/operators/rx-while_active.hpp>");
+    };
+};
+
 struct with_latest_from_tag {
     template<class Included>
     struct include_header{
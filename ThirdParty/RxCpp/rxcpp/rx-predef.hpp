@@ -18,6 +18,25 @@ inline auto trace_activity() -> decltype(rxcpp_trace_activity(trace_tag()))& {
     return trace;
 }
 
+inline trace_id trace_id::make_next_id_subscriber() {
+#if defined(RXCPP_THREAD_LOCAL)
+    // each thread takes a block of ids from the shared counter,
+    // so concurrent subscribes do not all write the same cache line.
+    static const unsigned long block_size = 1024;
+    static std::atomic<unsigned long> next_block(0xB0000000);
+    static RXCPP_THREAD_LOCAL unsigned long next;
+    static RXCPP_THREAD_LOCAL unsigned long end;
+    if (next == end) {
+        next = next_block.fetch_add(block_size, std::memory_order_relaxed);
+        end = next + block_size;
+    }
+    return trace_id{++next};
+#else
+    static std::atomic<unsigned long> id(0xB0000000);
+    return trace_id{++id};
+#endif
+}
+
 
 struct tag_action {};
 template<class T, class C = rxu::types_checked>
@@ -0,0 +1,423 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+/*! \file rx-recorder.hpp
+
+    \brief A flight recorder that keeps the last N emissions of several streams in a memory-mapped ring file.
+
+    Each record is a fixed size slot holding a sequence number, a timestamp, a
+    stream id and the raw bytes of a trivially copyable value. The file never
+    grows past slot_count slots, the oldest records are overwritten.
+
+    auto recorder = rxcpp::recorder::make_flight_recorder("input.rxfr", 1 << 16);
+    Tick.get_observable().record_to(recorder, 1).subscribe(...);
+
+    The payload size of a slot is a template argument, make_flight_recorder<64>(...) for larger values.
+    Opening an existing recording with the same layout keeps its records and appends after them.
+
+    auto replayed = rxcpp::sources::replay_from<float>("input.rxfr", 1, rxcpp::identity_same_worker(worker));
+
+    This header is not part of rx.hpp, it must be included explicitly.
+*/
+
+#if !defined(RXCPP_RX_RECORDER_HPP)
+#define RXCPP_RX_RECORDER_HPP
+
+#include "rx-includes.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#pragma push_macro("min")
+#pragma push_macro("max")
+#undef min
+#undef max
+
+#if defined(_WIN32)
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace rxcpp {
+
+namespace recorder {
+
+namespace detail {
+
+const std::uint32_t recording_magic = 0x52465852; // "RXFR"
+const std::uint32_t recording_version = 1;
+
+struct recording_header
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t slot_size;
+    std::uint32_t slot_count;
+    // sequence number of the next record, the slot is next % slot_count
+    std::atomic<std::uint64_t> next;
+    std::uint64_t reserved[5];
+};
+
+// the sequence of a slot that a writer is filling
+const std::uint64_t record_busy = ~std::uint64_t(0);
+
+struct record_header
+{
+    // sequence + 1 of the record in this slot, 0 when the slot was never written and
+    // record_busy while it is written. published with release after the rest of the
+    // record, readers load it before and after copying the record, see read_recording.
+    std::atomic<std::uint64_t> sequence;
+    std::int64_t timestamp;
+    std::uint32_t stream;
+    std::uint32_t size;
+};
+
+const std::uint32_t recording_header_size = 64;
+const std::uint32_t record_header_size = sizeof(record_header);
+
+class mapped_file
+{
+    mapped_file(const mapped_file&);
+    mapped_file& operator=(const mapped_file&);
+
+public:
+    mapped_file()
+        : data(nullptr)
+        , size(0)
+#if defined(_WIN32)
+        , file(INVALID_HANDLE_VALUE)
+        , mapping(nullptr)
+#endif
+    {
+    }
+    ~mapped_file()
+    {
+        close();
+    }
+
+    /// existed is set when the file was already length bytes long.
+    bool open(const std::string& path, std::size_t length, bool& existed) {
+        existed = false;
+#if defined(_WIN32)
+        file = ::CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER file_size;
+        existed = ::GetFileSizeEx(file, &file_size) && static_cast<std::uint64_t>(file_size.QuadPart) == length;
+        const auto high = static_cast<DWORD>(static_cast<std::uint64_t>(length) >> 32);
+        const auto low = static_cast<DWORD>(length & 0xFFFFFFFF);
+        mapping = ::CreateFileMappingA(file, nullptr, PAGE_READWRITE, high, low, nullptr);
+        if (!mapping) {
+            close();
+            return false;
+        }
+        data = ::MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, length);
+#else
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        existed = ::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) == length;
+        if (!existed && ::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+            ::close(fd);
+            return false;
+        }
+        void* p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        data = p == MAP_FAILED ? nullptr : p;
+#endif
+        if (!data) {
+            close();
+            return false;
+        }
+        size = length;
+        return true;
+    }
+
+    /// map the whole of an existing file for reading.
+    bool open_read(const std::string& path) {
+        std::size_t length = 0;
+#if defined(_WIN32)
+        file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER file_size;
+        if (!::GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+            close();
+            return false;
+        }
+        length = static_cast<std::size_t>(file_size.QuadPart);
+        mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            close();
+            return false;
+        }
+        data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        length = static_cast<std::size_t>(st.st_size);
+        void* p = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        data = p == MAP_FAILED ? nullptr : p;
+#endif
+        if (!data) {
+            close();
+            return false;
+        }
+        size = length;
+        return true;
+    }
+
+    void close() {
+#if defined(_WIN32)
+        if (data) {
+            ::UnmapViewOfFile(data);
+        }
+        if (mapping) {
+            ::CloseHandle(mapping);
+        }
+        if (file != INVALID_HANDLE_VALUE) {
+            ::CloseHandle(file);
+        }
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (data) {
+            ::munmap(data, size);
+        }
+#endif
+        data = nullptr;
+        size = 0;
+    }
+
+    void* data;
+    std::size_t size;
+
+private:
+#if defined(_WIN32)
+    HANDLE file;
+    HANDLE mapping;
+#endif
+};
+
+}
+
+/*!
+    \brief appends fixed size records to a memory-mapped ring file.
+
+    record() may be called from any thread. It costs one relaxed atomic
+    increment, a compare-exchange on the slot and a copy into the mapping, the
+    OS writes the pages back. When the file cannot be mapped the recorder is
+    closed and record() does nothing.
+
+    \tparam PayloadSize  the largest value a record holds, checked when a type is recorded
+
+    \ingroup group-core
+*/
+template<std::uint32_t PayloadSize = 16>
+class basic_flight_recorder
+{
+    basic_flight_recorder(const basic_flight_recorder&);
+    basic_flight_recorder& operator=(const basic_flight_recorder&);
+
+public:
+    typedef rxsc::scheduler::clock_type clock_type;
+
+    static const std::uint32_t payload_capacity = PayloadSize;
+    static const std::uint32_t slot_size = (detail::record_header_size + PayloadSize + 7) & ~std::uint32_t(7);
+
+    basic_flight_recorder(const std::string& path, std::uint32_t slot_count)
+        : header(nullptr)
+        , slots(nullptr)
+        , slot_count(slot_count)
+    {
+        if (slot_count == 0) {
+            return;
+        }
+        bool existed = false;
+        if (!file.open(path, detail::recording_header_size + std::size_t(slot_size) * slot_count, existed)) {
+            return;
+        }
+        slots = static_cast<char*>(file.data) + detail::recording_header_size;
+        auto existing = static_cast<detail::recording_header*>(file.data);
+        if (existed && existing->magic == detail::recording_magic && existing->version == detail::recording_version &&
+            existing->slot_size == slot_size && existing->slot_count == slot_count) {
+            // keep the earlier recording, eg. of a session that crashed. a
+            // slot whose writer died while it was busy is dropped.
+            header = existing;
+            for (std::uint32_t i = 0; i != slot_count; ++i) {
+                auto rh = reinterpret_cast<detail::record_header*>(slots + std::size_t(i) * slot_size);
+                if (rh->sequence.load(std::memory_order_relaxed) == detail::record_busy) {
+                    rh->sequence.store(0, std::memory_order_relaxed);
+                }
+            }
+            return;
+        }
+        header = new (file.data) detail::recording_header();
+        header->magic = detail::recording_magic;
+        header->version = detail::recording_version;
+        header->slot_size = slot_size;
+        header->slot_count = slot_count;
+        header->next.store(0, std::memory_order_relaxed);
+        std::memset(slots, 0, std::size_t(slot_size) * slot_count);
+    }
+
+    bool is_open() const {
+        return !!header;
+    }
+
+    std::uint32_t payload_size() const {
+        return PayloadSize;
+    }
+
+    template<class T>
+    void record(std::uint32_t stream, clock_type::time_point when, const T& value) const {
+        static_assert(std::is_trivially_copyable<T>::value, "flight_recorder can only record trivially copyable values");
+        static_assert(sizeof(T) <= PayloadSize, "the value does not fit the payload, use a basic_flight_recorder with a larger PayloadSize");
+        write(stream, when, std::addressof(value), static_cast<std::uint32_t>(sizeof(T)));
+    }
+
+private:
+    void write(std::uint32_t stream, clock_type::time_point when, const void* payload, std::uint32_t size) const {
+        if (!header) {
+            return;
+        }
+        auto sequence = header->next.fetch_add(1, std::memory_order_relaxed);
+        auto slot = slots + std::size_t(sequence % slot_count) * slot_size;
+        auto rh = reinterpret_cast<detail::record_header*>(slot);
+
+        // after a wrap-around a writer from the previous lap may still be in
+        // this slot, wait for it. a slot that already holds a later record
+        // is left alone.
+        auto current = rh->sequence.load(std::memory_order_relaxed);
+        for (;;) {
+            if (current == detail::record_busy) {
+                std::this_thread::yield();
+                current = rh->sequence.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (current > sequence) {
+                return;
+            }
+            if (rh->sequence.compare_exchange_weak(current, detail::record_busy, std::memory_order_acquire, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        // readers must not see the new record bytes before the busy marker
+        std::atomic_thread_fence(std::memory_order_release);
+
+        rh->timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(when.time_since_epoch()).count();
+        rh->stream = stream;
+        rh->size = size;
+        std::memcpy(slot + detail::record_header_size, payload, size);
+
+        rh->sequence.store(sequence + 1, std::memory_order_release);
+    }
+
+    detail::mapped_file file;
+    detail::recording_header* header;
+    char* slots;
+    std::uint32_t slot_count;
+};
+
+typedef basic_flight_recorder<> flight_recorder;
+
+template<std::uint32_t PayloadSize = 16>
+std::shared_ptr<basic_flight_recorder<PayloadSize>> make_flight_recorder(const std::string& path, std::uint32_t slot_count) {
+    return std::make_shared<basic_flight_recorder<PayloadSize>>(path, slot_count);
+}
+
+template<class T>
+struct recorded_value
+{
+    typedef rxsc::scheduler::clock_type clock_type;
+
+    clock_type::duration time;
+    T value;
+};
+
+/// read the records of one stream, oldest first. An unreadable file yields no records.
+///
+/// the file may still be recorded to. a record that is rewritten while it is
+/// read is skipped.
+template<class T>
+std::vector<recorded_value<T>> read_recording(const std::string& path, std::uint32_t stream) {
+    static_assert(std::is_trivially_copyable<T>::value, "flight_recorder can only replay trivially copyable values");
+    typedef typename recorded_value<T>::clock_type clock_type;
+
+    std::vector<recorded_value<T>> result;
+
+    detail::mapped_file file;
+    if (!file.open_read(path) || file.size < detail::recording_header_size) {
+        return result;
+    }
+
+    auto header = static_cast<const detail::recording_header*>(file.data);
+    if (header->magic != detail::recording_magic || header->version != detail::recording_version || header->slot_count == 0 ||
+        file.size < detail::recording_header_size + std::size_t(header->slot_size) * header->slot_count) {
+        return result;
+    }
+    const auto slot_size = header->slot_size;
+    const auto slot_count = header->slot_count;
+    if (slot_size < detail::record_header_size + sizeof(T)) {
+        return result;
+    }
+    const auto next = header->next.load(std::memory_order_acquire);
+
+    const char* slots = static_cast<const char*>(file.data) + detail::recording_header_size;
+    auto first = next > slot_count ? next - slot_count : 0;
+    for (auto sequence = first; sequence != next; ++sequence) {
+        auto slot = slots + std::size_t(sequence % slot_count) * slot_size;
+        auto rh = reinterpret_cast<const detail::record_header*>(slot);
+        if (rh->sequence.load(std::memory_order_acquire) != sequence + 1) {
+            continue;
+        }
+        auto timestamp = rh->timestamp;
+        auto recorded_stream = rh->stream;
+        auto recorded_size = rh->size;
+        if (recorded_stream != stream || recorded_size != sizeof(T)) {
+            continue;
+        }
+        recorded_value<T> r;
+        std::memcpy(std::addressof(r.value), slot + detail::record_header_size, sizeof(T));
+        // the copy is only valid if no writer took the slot while it was made
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (rh->sequence.load(std::memory_order_relaxed) != sequence + 1) {
+            continue;
+        }
+        r.time = std::chrono::duration_cast<typename clock_type::duration>(std::chrono::nanoseconds(timestamp));
+        result.push_back(r);
+    }
+    return result;
+}
+
+}
+
+}
+
+#pragma pop_macro("min")
+#pragma pop_macro("max")
+
+#include "operators/rx-record_to.hpp"
+#include "sources/rx-replay_from.hpp"
+
+#endif
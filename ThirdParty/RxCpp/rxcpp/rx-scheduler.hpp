@@ -416,6 +416,8 @@ public:
 
 template<class Scheduler, class... ArgN>
 inline scheduler make_scheduler(ArgN&&... an) {
+    // a scheduler outlives the chain that it may be created in
+    rxcpp::detail::heap_scope heap;
     return scheduler(std::static_pointer_cast<scheduler_interface>(std::make_shared<Scheduler>(std::forward<ArgN>(an)...)));
 }
 
@@ -956,6 +958,7 @@ namespace rxsc=schedulers;
 #include "schedulers/rx-eventloop.hpp"
 #include "schedulers/rx-immediate.hpp"
 #include "schedulers/rx-virtualtime.hpp"
+#include "schedulers/rx-frameclock.hpp"
 #include "schedulers/rx-sameworker.hpp"
 
 #endif
@@ -20,5 +20,6 @@ namespace rxsub=subjects;
 #include "subjects/rx-behavior.hpp"
 #include "subjects/rx-replaysubject.hpp"
 #include "subjects/rx-synchronize.hpp"
+#include "subjects/rx-frame_input.hpp"
 
 #endif
@@ -11,6 +11,41 @@ namespace rxcpp {
 
 namespace detail {
 
+// the pointers, flags and locks that subscriptions use, see rx-confined.hpp.
+#if defined(RXCPP_THREAD_CONFINED)
+template<class T>
+using lifetime_ptr = rxu::confined_ptr<T>;
+template<class T>
+using lifetime_weak_ptr = rxu::confined_weak_ptr<T>;
+typedef rxu::confined_flag lifetime_flag;
+typedef rxu::confined_mutex lifetime_mutex;
+
+template<class T, class... AN>
+lifetime_ptr<T> make_lifetime(AN&&... an) {
+    return rxu::allocate_confined<T>(rxu::arena_allocator<T>(), std::forward<AN>(an)...);
+}
+template<class T, class... AN>
+lifetime_ptr<T> make_heap_lifetime(AN&&... an) {
+    return rxu::allocate_confined<T>(std::allocator<T>(), std::forward<AN>(an)...);
+}
+#else
+template<class T>
+using lifetime_ptr = std::shared_ptr<T>;
+template<class T>
+using lifetime_weak_ptr = std::weak_ptr<T>;
+typedef std::atomic<bool> lifetime_flag;
+typedef std::mutex lifetime_mutex;
+
+template<class T, class... AN>
+lifetime_ptr<T> make_lifetime(AN&&... an) {
+    return rxu::make_arena_shared<T>(std::forward<AN>(an)...);
+}
+template<class T, class... AN>
+lifetime_ptr<T> make_heap_lifetime(AN&&... an) {
+    return std::make_shared<T>(std::forward<AN>(an)...);
+}
+#endif
+
 template<class F>
 struct is_unsubscribe_function
 {
@@ -64,9 +99,17 @@ public:
     }
 };
 
+class composite_subscription;
+
+namespace detail {
+
+class composite_subscription_inner;
+
+}
+
 class subscription : public subscription_base
 {
-    class base_subscription_state : public std::enable_shared_from_this<base_subscription_state>
+    class base_subscription_state
     {
         base_subscription_state();
     public:
@@ -78,10 +121,14 @@ class subscription : public subscription_base
         virtual ~base_subscription_state() {}
         virtual void unsubscribe() {
         }
-        std::atomic<bool> issubscribed;
+        // unsubscribes, but a composite appends its subscriptions to pending instead of unsubscribing them.
+        virtual void unsubscribe_into(std::vector<subscription>&) {
+            unsubscribe();
+        }
+        detail::lifetime_flag issubscribed;
     };
 public:
-    typedef std::weak_ptr<base_subscription_state> weak_state_type;
+    typedef detail::lifetime_weak_ptr<base_subscription_state> weak_state_type;
 
 private:
     template<class I>
@@ -103,8 +150,26 @@ private:
         inner_t inner;
     };
 
+    // the composite state is a base_subscription_state, see composite_subscription_state
+    friend class detail::composite_subscription_inner;
+    friend class composite_subscription;
+
+    // unsubscribes each of the subscriptions, and the subscriptions of the composites among them, with a
+    // loop instead of recursion. the nested states are released together when pending is destroyed.
+    template<class Subscriptions>
+    static void unsubscribe_each(const Subscriptions& subscriptions) {
+        std::vector<subscription> pending;
+        for (auto& s : subscriptions) {
+            s.state.get()->unsubscribe_into(pending);
+        }
+        for (std::size_t i = 0; i != pending.size(); ++i) {
+            // pending may grow and move, the state is kept alive by the subscription in pending
+            pending[i].state.get()->unsubscribe_into(pending);
+        }
+    }
+
 protected:
-    std::shared_ptr<base_subscription_state> state;
+    detail::lifetime_ptr<base_subscription_state> state;
 
     friend bool operator<(const subscription&, const subscription&);
     friend bool operator==(const subscription&, const subscription&);
@@ -118,7 +183,7 @@ private:
         }
     }
 
-    explicit subscription(std::shared_ptr<base_subscription_state> s)
+    explicit subscription(detail::lifetime_ptr<base_subscription_state> s)
         : state(std::move(s))
     {
         if (!state) {
@@ -128,7 +193,7 @@ private:
 public:
 
     subscription()
-        : state(std::make_shared<base_subscription_state>(false))
+        : state(detail::make_lifetime<base_subscription_state>(false))
     {
         if (!state) {
             std::terminate();
@@ -136,7 +201,7 @@ public:
     }
     template<class U>
     explicit subscription(U u, typename std::enable_if<!is_subscription<U>::value, void**>::type = nullptr)
-        : state(std::make_shared<subscription_state<U>>(std::move(u)))
+        : state(detail::make_lifetime<subscription_state<U>>(std::move(u)))
     {
         if (!state) {
             std::terminate();
@@ -158,7 +223,8 @@ public:
             std::terminate();
         }
     }
-    subscription(subscription&& o)
+    // noexcept so that std::vector<subscription> moves instead of copying when it grows
+    subscription(subscription&& o) RXCPP_NOEXCEPT
         : state(std::move(o.state))
     {
         if (!state) {
@@ -243,33 +309,72 @@ class composite_subscription_inner
 {
 private:
     typedef subscription::weak_state_type weak_subscription;
-    struct composite_subscription_state : public std::enable_shared_from_this<composite_subscription_state>
+    // also the state of the subscription base of composite_subscription,
+    // so that a composite_subscription is one allocation.
+    struct composite_subscription_state : public subscription::base_subscription_state
     {
-        // invariant: cannot access this data without the lock held.
-        std::set<subscription> subscriptions;
-        // double checked locking:
-        //    issubscribed must be loaded again after each lock acquisition.
-        // invariant:
-        //    never call subscription::unsubscribe with lock held.
-        std::mutex lock;
+        // the set keeps allocating for as long as the composite lives, on any
+        // thread, so it uses the heap rather than the arena that was active
+        // when it was created.
+        typedef std::set<subscription> subscriptions_type;
+
+        // most subscribers never have a subscription added to them, so the set
+        // and the lock are not allocated until the first add().
+        struct children_type
+        {
+            // invariant: cannot access this data without the lock held.
+            subscriptions_type subscriptions;
+            // double checked locking:
+            //    issubscribed must be loaded again after each lock acquisition.
+            // invariant:
+            //    never call subscription::unsubscribe with lock held.
+            lifetime_mutex lock;
+        };
+
+        // invariant: transitions from nullptr to the children at most once, in add().
+        // unsubscribe() stores issubscribed and then loads children, add() stores
+        // children and then loads issubscribed, so at least one of them sees the other.
+        std::atomic<children_type*> children;
+        // base_subscription_state::issubscribed
         // invariant: transitions from 'true' to 'false' exactly once, at any time.
-        std::atomic<bool> issubscribed;
 
         ~composite_subscription_state()
         {
-            std::unique_lock<decltype(lock)> guard(lock);
-            subscriptions.clear();
+            if (auto c = children.load()) {
+                {
+                    std::unique_lock<decltype(c->lock)> guard(c->lock);
+                    c->subscriptions.clear();
+                }
+                delete c;
+            }
         }
 
         composite_subscription_state()
-            : issubscribed(true)
+            : base_subscription_state(true)
+            , children(nullptr)
         {
         }
         composite_subscription_state(tag_composite_subscription_empty)
-            : issubscribed(false)
+            : base_subscription_state(false)
+            , children(nullptr)
         {
         }
 
+        // returns the children, the first call allocates them.
+        children_type* get_children() {
+            auto c = children.load();  // load.acq [seq_cst]
+            if (!c) {
+                auto created = new children_type();
+                if (children.compare_exchange_strong(c, created)) {  // cas.acq_rel [seq_cst]
+                    c = created;
+                } else {
+                    // a concurrent add() stored its children in c.
+                    delete created;
+                }
+            }
+            return c;
+        }
+
         // Atomically add 's' to the set of subscriptions.
         //
         // If unsubscribe() has already occurred, this immediately
@@ -285,14 +390,15 @@ private:
             if (!issubscribed) {  // load.acq [seq_cst]
                 s.unsubscribe();
             } else if (s.is_subscribed()) {
-                std::unique_lock<decltype(lock)> guard(lock);
+                auto c = get_children();
+                std::unique_lock<decltype(c->lock)> guard(c->lock);
                 if (!issubscribed) {  // load.acq [seq_cst]
                     // unsubscribe was called concurrently.
                     guard.unlock();
                     // invariant: do not call unsubscribe with lock held.
                     s.unsubscribe();
                 } else {
-                    subscriptions.insert(s);
+                    c->subscriptions.insert(s);
                 }
             }
             return s.get_weak();
@@ -304,6 +410,12 @@ private:
         // or refers to an expired value.
         inline void remove(weak_subscription w) {
             if (issubscribed) { // load.acq [seq_cst]
+                auto c = children.load();  // load.acq [seq_cst]
+                if (!c) {
+                  // Do nothing if nothing was ever added.
+                  return;
+                }
+
                 rxu::maybe<subscription> maybe_subscription = subscription::maybe_lock(w);
 
                 if (maybe_subscription.empty()) {
@@ -311,12 +423,12 @@ private:
                   return;
                 }
 
-                std::unique_lock<decltype(lock)> guard(lock);
+                std::unique_lock<decltype(c->lock)> guard(c->lock);
                 // invariant: subscriptions must be accessed under the lock.
 
                 if (issubscribed) { // load.acq [seq_cst]
                   subscription& s = maybe_subscription.get();
-                  subscriptions.erase(std::move(s));
+                  c->subscriptions.erase(std::move(s));
                 } // else unsubscribe() was called concurrently; this becomes a no-op.
             }
         }
@@ -333,19 +445,23 @@ private:
         // cs.unsubscribe() observed-before cs.clear ==> do nothing.
         inline void clear() {
             if (issubscribed) { // load.acq [seq_cst]
-                std::unique_lock<decltype(lock)> guard(lock);
+                auto c = children.load();  // load.acq [seq_cst]
+                if (!c) {
+                  // nothing was ever added.
+                  return;
+                }
+
+                std::unique_lock<decltype(c->lock)> guard(c->lock);
 
                 if (!issubscribed) { // load.acq [seq_cst]
                   // unsubscribe was called concurrently.
                   return;
                 }
 
-                std::set<subscription> v(std::move(subscriptions));
+                subscriptions_type v(std::move(c->subscriptions));
                 // invariant: do not call unsubscribe with lock held.
                 guard.unlock();
-                std::for_each(v.begin(), v.end(),
-                              [](const subscription& s) {
-                                s.unsubscribe(); });
+                subscription::unsubscribe_each(v);
             }
         }
 
@@ -363,36 +479,71 @@ private:
         // forall subscriptions in {add(s1),add(s2),...}
         //                         - {remove(s3), remove(s4), ...}:
         //   cs.unsubscribe() || cs.clear() happens before s.unsubscribe()
-        inline void unsubscribe() {
+        virtual void unsubscribe() {
             if (issubscribed.exchange(false)) {  // cas.acq_rel [seq_cst]
-                std::unique_lock<decltype(lock)> guard(lock);
+                trace_activity().unsubscribe_enter(*this);
+                // when there are no children a concurrent add() will see issubscribed == false.
+                if (auto c = children.load()) {  // load.acq [seq_cst]
+                    std::unique_lock<decltype(c->lock)> guard(c->lock);
 
-                // is_subscribed can only transition to 'false' once,
-                // does not need an extra atomic access here.
+                    // is_subscribed can only transition to 'false' once,
+                    // does not need an extra atomic access here.
 
-                std::set<subscription> v(std::move(subscriptions));
-                // invariant: do not call unsubscribe with lock held.
-                guard.unlock();
-                std::for_each(v.begin(), v.end(),
-                              [](const subscription& s) {
-                                s.unsubscribe(); });
+                    subscriptions_type v(std::move(c->subscriptions));
+                    // invariant: do not call unsubscribe with lock held.
+                    guard.unlock();
+                    subscription::unsubscribe_each(v);
+                }
+                trace_activity().unsubscribe_return(*this);
             }
         }
+
+        // unsubscribe(), except that the subscriptions are appended to
+        // pending instead of being unsubscribed. this lets a tree of
+        // composite subscriptions be unsubscribed with one loop.
+        virtual void unsubscribe_into(std::vector<subscription>& pending) {
+            if (issubscribed.exchange(false)) {  // cas.acq_rel [seq_cst]
+                trace_activity().unsubscribe_enter(*this);
+                // when there are no children a concurrent add() will see issubscribed == false.
+                if (auto c = children.load()) {  // load.acq [seq_cst]
+                    std::unique_lock<decltype(c->lock)> guard(c->lock);
+
+                    // is_subscribed can only transition to 'false' once,
+                    // does not need an extra atomic access here.
+
+                    subscriptions_type v(std::move(c->subscriptions));
+                    // invariant: do not call unsubscribe with lock held.
+                    guard.unlock();
+                    take(v, pending);
+                }
+                trace_activity().unsubscribe_return(*this);
+            }
+        }
+
+        // moves the subscriptions in v to the end of pending and empties v.
+        static void take(subscriptions_type& v, std::vector<subscription>& pending) {
+            for (auto& s : v) {
+                // the elements are only const to protect the order of the set,
+                // which does not matter because v is cleared right after.
+                pending.push_back(std::move(const_cast<subscription&>(s)));
+            }
+            v.clear();
+        }
     };
 
 public:
-    typedef std::shared_ptr<composite_subscription_state> shared_state_type;
+    typedef lifetime_ptr<composite_subscription_state> shared_state_type;
 
 protected:
     mutable shared_state_type state;
 
 public:
     composite_subscription_inner()
-        : state(std::make_shared<composite_subscription_state>())
+        : state(make_lifetime<composite_subscription_state>())
     {
     }
     composite_subscription_inner(tag_composite_subscription_empty et)
-        : state(std::make_shared<composite_subscription_state>(et))
+        : state(make_heap_lifetime<composite_subscription_state>(et))
     {
     }
 
@@ -461,12 +612,13 @@ class composite_subscription
     , public subscription
 {
     typedef detail::composite_subscription_inner inner_type;
+    typedef detail::lifetime_ptr<subscription::base_subscription_state> base_state_type;
 public:
     typedef subscription::weak_state_type weak_subscription;
 
     composite_subscription(detail::tag_composite_subscription_empty et)
         : inner_type(et)
-        , subscription() // use empty base
+        , subscription(base_state_type(inner_type::state)) // share the empty state
     {
     }
 
@@ -474,7 +626,7 @@ public:
 
     composite_subscription()
         : inner_type()
-        , subscription(*static_cast<const inner_type*>(this))
+        , subscription(base_state_type(inner_type::state)) // share the composite state
     {
     }
 
@@ -545,8 +697,17 @@ inline bool operator!=(const composite_subscription& lhs, const composite_subscr
 namespace detail {
 
 inline composite_subscription shared_empty() {
+#if defined(RXCPP_THREAD_CONFINED) && defined(RXCPP_THREAD_LOCAL)
+    // one for each thread, never released, so that no count is shared across threads.
+    static RXCPP_THREAD_LOCAL composite_subscription* shared_empty;
+    if (!shared_empty) {
+        shared_empty = new composite_subscription(tag_composite_subscription_empty());
+    }
+    return *shared_empty;
+#else
     static composite_subscription shared_empty = composite_subscription(tag_composite_subscription_empty());
     return shared_empty;
+#endif
 }
 
 }
@@ -13,10 +13,8 @@ namespace rxcpp {
 
 struct trace_id
 {
-    static inline trace_id make_next_id_subscriber() {
-        static std::atomic<unsigned long> id(0xB0000000);
-        return trace_id{++id};
-    }
+    // defined in rx-predef.hpp
+    static trace_id make_next_id_subscriber();
     unsigned long id;
 };
 
@@ -872,8 +872,182 @@ struct error_specific : public error_base {
   E data;
 };
 
+// the address of key identifies the type E without RTTI. key is not const
+// so that the linker does not fold the keys of different types together.
+template <class E>
+struct error_type
+{
+  static char key;
+};
+template <class E>
+char error_type<E>::key = 0;
+
+}
+
+/// the type and message of an error, interned for the life of the process.
+struct error_info {
+  const void* type;
+  const char* message;
+};
+
+namespace detail {
+
+struct interned_error_info
+{
+  error_info info;
+  std::uint64_t hash;
+  std::string text;
+  interned_error_info* next;
+};
+
+inline std::uint64_t error_info_hash(const void* type, const char* message, bool copy) {
+  std::uint64_t h = reinterpret_cast<std::uintptr_t>(type);
+  if (copy) {
+    for (; *message; ++message) {
+      h = (h ^ static_cast<unsigned char>(*message)) * 1099511628211ull;
+    }
+  } else {
+    h = h * 31 + reinterpret_cast<std::uintptr_t>(message);
+  }
+  return h * 11400714819323198485ull;
 }
 
+// copied messages are kept for the life of the process, so only this many are
+// interned. errors with other messages keep their exception object instead.
+const std::size_t max_interned_messages = 256;
+
+// a table that only grows, lookups do not lock or allocate. a message that
+// is copied is matched by its text, one that is not is matched by its address.
+// returns nullptr for a copied message that is new once the table is full.
+inline const error_info* intern_error_info(const void* type, const char* message, bool copy) {
+  static std::atomic<interned_error_info*> buckets[2][64];
+  static std::atomic<std::size_t> copied(0);
+  auto hash = error_info_hash(type, message, copy);
+  auto matches = [&](const interned_error_info* entry) {
+    return entry->hash == hash && entry->info.type == type &&
+      (copy ? entry->text == message : entry->info.message == message);
+  };
+  auto& bucket = buckets[copy ? 1 : 0][hash >> 58];
+  auto head = bucket.load(std::memory_order_acquire);
+  for (auto entry = head; entry; entry = entry->next) {
+    if (matches(entry)) {
+      return &entry->info;
+    }
+  }
+  if (copy && copied.fetch_add(1, std::memory_order_relaxed) >= max_interned_messages) {
+    copied.fetch_sub(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  auto added = new interned_error_info{{type, message}, hash, copy ? message : "", head};
+  if (copy) {
+    added->info.message = added->text.c_str();
+  }
+  while (!bucket.compare_exchange_weak(added->next, added, std::memory_order_acq_rel)) {
+    for (auto entry = added->next; entry != head; entry = entry->next) {
+      if (matches(entry)) {
+        delete added;
+        if (copy) {
+          copied.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return &entry->info;
+      }
+    }
+    head = added->next;
+  }
+  return &added->info;
+}
+
+// the error_info of a rich error, the message comes from the exception object.
+template <class E>
+const error_info& type_error_info() {
+  static const error_info info = {&error_type<E>::key, ""};
+  return info;
+}
+
+}
+
+/// the error_info for errors of type E with message, the first call for each pair allocates.
+/// once detail::max_interned_messages messages are interned, a new message gets an error_info
+/// of E with an empty message.
+template <class E>
+const error_info& intern_error_info(const char* message) {
+  auto info = detail::intern_error_info(&detail::error_type<rxcpp::util::decay_t<E>>::key, message, true);
+  return info ? *info : detail::type_error_info<rxcpp::util::decay_t<E>>();
+}
+/// intern_error_info for a message that has static storage duration, it is not copied.
+template <class E>
+const error_info& intern_static_error_info(const char* message) {
+  return *detail::intern_error_info(&detail::error_type<rxcpp::util::decay_t<E>>::key, message, false);
+}
+
+/*!
+    \brief an error that is an error code and a pointer to an interned error_info, or a rich error that keeps the exception object.
+
+    Copies do not allocate or use atomic operations, unless the error is rich.
+*/
+class error_ptr
+{
+  const error_info* info;
+  int value;
+  std::shared_ptr<detail::error_base> rich;
+
+public:
+  error_ptr()
+    : info(nullptr)
+    , value(0)
+  {
+  }
+  error_ptr(std::nullptr_t)
+    : info(nullptr)
+    , value(0)
+  {
+  }
+  explicit error_ptr(const error_info& i, int code = 0)
+    : info(&i)
+    , value(code)
+  {
+  }
+  error_ptr(const error_info& i, std::shared_ptr<detail::error_base> r)
+    : info(&i)
+    , value(0)
+    , rich(std::move(r))
+  {
+  }
+
+  explicit operator bool() const {
+    return info != nullptr;
+  }
+  bool operator!() const {
+    return info == nullptr;
+  }
+
+  int code() const {
+    return value;
+  }
+  /// true when the error was made from an E.
+  template <class E>
+  bool is() const {
+    return info && info->type == &detail::error_type<rxcpp::util::decay_t<E>>::key;
+  }
+  const char* what() const {
+    if (rich) {
+      return rich->what();
+    }
+    return info ? info->message : "";
+  }
+  /// the exception object of a rich error, otherwise nullptr.
+  detail::error_base* get_rich() const {
+    return rich.get();
+  }
+
+  friend bool operator==(const error_ptr& lhs, const error_ptr& rhs) {
+    return lhs.info == rhs.info && lhs.value == rhs.value && lhs.rich == rhs.rich;
+  }
+  friend bool operator!=(const error_ptr& lhs, const error_ptr& rhs) {
+    return !(lhs == rhs);
+  }
+};
+
 }
 #endif
 
@@ -885,10 +1059,10 @@ using error_ptr = std::exception_ptr;
 // Note: std::exception_ptr cannot be used directly when exceptions are disabled.
 // Any attempt to 'throw' or to call into any of the std functions accepting
 // an std::exception_ptr will either fail to compile or result in an abort at runtime.
-using error_ptr = std::shared_ptr<util::detail::error_base>;
+// error_ptr is defined above.
 
 inline std::string what(error_ptr ep) {
-    return std::string(ep->what());
+    return std::string(ep.what());
 }
 #endif
 
@@ -898,17 +1072,48 @@ inline error_ptr make_error_ptr(error_ptr e) {
   return e;
 }
 
-// Replace std::make_exception_ptr (which would immediately terminate
-// when exceptions are disabled).
+// An error that keeps e, so that it can be rethrown, or when exceptions
+// are disabled, inspected with error_ptr::get_rich().
 template <class E>
-error_ptr make_error_ptr(E&& e) {
+error_ptr make_rich_error_ptr(E&& e) {
 #if RXCPP_USE_EXCEPTIONS
     return std::make_exception_ptr(std::forward<E>(e));
 #else
     using e_type = rxcpp::util::decay_t<E>;
     using pointed_to_type = rxcpp::util::detail::error_specific<e_type>;
+    const error_info& info = detail::type_error_info<e_type>();
     auto sp = std::make_shared<pointed_to_type>(std::forward<E>(e));
-    return std::static_pointer_cast<rxcpp::util::detail::error_base>(sp);
+    return error_ptr(info, std::static_pointer_cast<rxcpp::util::detail::error_base>(sp));
+#endif
+}
+
+// Replace std::make_exception_ptr (which would immediately terminate
+// when exceptions are disabled).
+//
+// When exceptions are disabled the error keeps the type and what() of e,
+// interned, and not e itself. Use make_rich_error_ptr to keep e. Once the
+// table of messages is full, an error with a new message keeps e as well.
+template <class E>
+error_ptr make_error_ptr(E&& e) {
+#if RXCPP_USE_EXCEPTIONS
+    return std::make_exception_ptr(std::forward<E>(e));
+#else
+    if (auto info = detail::intern_error_info(&detail::error_type<rxcpp::util::decay_t<E>>::key, e.what(), true)) {
+        return error_ptr(*info);
+    }
+    return make_rich_error_ptr(std::forward<E>(e));
+#endif
+}
+
+// An error of type E with a message that has static storage duration.
+// When exceptions are disabled E is not constructed and, after the first
+// call with the same message, nothing is allocated.
+template <class E>
+error_ptr make_static_error_ptr(const char* message) {
+#if RXCPP_USE_EXCEPTIONS
+    return std::make_exception_ptr(E(message));
+#else
+    return error_ptr(intern_static_error_info<E>(message));
 #endif
 }
 
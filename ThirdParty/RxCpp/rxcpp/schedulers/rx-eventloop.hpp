@@ -17,6 +17,92 @@ private:
     typedef event_loop this_type;
     event_loop(const this_type&);
 
+    // a loop thread is started by the first worker that is assigned to its
+    // slot. when the last worker of a slot is released and idle_timeout is
+    // set, the thread is retired if no new worker arrives before the timeout.
+    struct loop_slot
+    {
+        loop_slot()
+            : users(0)
+            , generation(0)
+            , started(false)
+        {
+        }
+        worker loop;
+        composite_subscription::weak_subscription token;
+        std::size_t users;
+        std::size_t generation;
+        bool started;
+    };
+
+    struct loops_state : public std::enable_shared_from_this<loops_state>
+    {
+        loops_state(scheduler nt, std::size_t max_threads, clock_type::duration idle)
+            : newthread(std::move(nt))
+            , slots(std::max(max_threads, std::size_t(1)))
+            , idle_timeout(idle)
+        {
+        }
+
+        worker acquire(std::size_t index) {
+            std::unique_lock<std::mutex> guard(lock);
+            auto& slot = slots[index];
+            if (!slot.started) {
+                // the loop outlives the chain that starts it
+                rxcpp::detail::heap_scope heap;
+                composite_subscription cs;
+                slot.token = lifetime.add(cs);
+                slot.loop = newthread.create_worker(cs);
+                slot.started = true;
+            }
+            ++slot.users;
+            ++slot.generation;
+            return slot.loop;
+        }
+
+        void release(std::size_t index) {
+            std::unique_lock<std::mutex> guard(lock);
+            auto& slot = slots[index];
+            if (--slot.users != 0 || idle_timeout == clock_type::duration::zero() || !lifetime.is_subscribed()) {
+                return;
+            }
+            auto generation = ++slot.generation;
+            auto keepAlive = this->shared_from_this();
+            slot.loop.schedule(slot.loop.now() + idle_timeout, [keepAlive, index, generation](const schedulable&){
+                keepAlive->retire(index, generation);
+            });
+        }
+
+        void retire(std::size_t index, std::size_t generation) {
+            std::unique_lock<std::mutex> guard(lock);
+            auto& slot = slots[index];
+            if (!slot.started || slot.users != 0 || slot.generation != generation) {
+                return;
+            }
+            auto retired = std::move(slot.loop);
+            lifetime.remove(slot.token);
+            slot.loop = worker();
+            slot.token = composite_subscription::weak_subscription();
+            slot.started = false;
+            guard.unlock();
+            // called on the retired thread, new_thread detaches it and the loop exits.
+            retired.unsubscribe();
+        }
+
+        std::size_t running() const {
+            std::unique_lock<std::mutex> guard(lock);
+            return static_cast<std::size_t>(std::count_if(slots.begin(), slots.end(), [](const loop_slot& slot){
+                return slot.started;
+            }));
+        }
+
+        scheduler newthread;
+        mutable std::mutex lock;
+        std::vector<loop_slot> slots;
+        clock_type::duration idle_timeout;
+        composite_subscription lifetime;
+    };
+
     struct loop_worker : public worker_interface
     {
     private:
@@ -36,14 +122,16 @@ private:
         virtual ~loop_worker()
         {
         }
-        loop_worker(composite_subscription cs, worker w, std::shared_ptr<const scheduler_interface> alive)
+        loop_worker(composite_subscription cs, std::shared_ptr<loops_state> loops, std::size_t index, std::shared_ptr<const scheduler_interface> alive)
             : lifetime(cs)
-            , controller(w)
+            , controller(loops->acquire(index))
             , alive(alive)
         {
+            auto w = controller;
             auto token = controller.add(cs);
-            cs.add([token, w](){
+            cs.add([token, w, loops, index](){
                 w.remove(token);
+                loops->release(index);
             });
         }
 
@@ -61,37 +149,39 @@ private:
     };
 
     mutable thread_factory factory;
-    scheduler newthread;
     mutable std::atomic<std::size_t> count;
-    composite_subscription loops_lifetime;
-    std::vector<worker> loops;
+    std::shared_ptr<loops_state> loops;
+
+    static std::size_t default_max_threads() {
+        return std::max(std::thread::hardware_concurrency(), unsigned(4));
+    }
 
 public:
     event_loop()
         : factory([](std::function<void()> start){
             return std::thread(std::move(start));
         })
-        , newthread(make_new_thread())
         , count(0)
+        , loops(std::make_shared<loops_state>(make_new_thread(), default_max_threads(), clock_type::duration::zero()))
     {
-        auto remaining = std::max(std::thread::hardware_concurrency(), unsigned(4));
-        while (remaining--) {
-            loops.push_back(newthread.create_worker(loops_lifetime));
-        }
     }
     explicit event_loop(thread_factory tf)
         : factory(tf)
-        , newthread(make_new_thread(tf))
         , count(0)
+        , loops(std::make_shared<loops_state>(make_new_thread(tf), default_max_threads(), clock_type::duration::zero()))
+    {
+    }
+    /// start at most max_threads loops, on demand. a loop with no workers left
+    /// is stopped after idle_timeout, zero keeps idle loops running.
+    event_loop(thread_factory tf, std::size_t max_threads, clock_type::duration idle_timeout)
+        : factory(tf)
+        , count(0)
+        , loops(std::make_shared<loops_state>(make_new_thread(tf), max_threads, idle_timeout))
     {
-        auto remaining = std::max(std::thread::hardware_concurrency(), unsigned(4));
-        while (remaining--) {
-            loops.push_back(newthread.create_worker(loops_lifetime));
-        }
     }
     virtual ~event_loop()
     {
-        loops_lifetime.unsubscribe();
+        loops->lifetime.unsubscribe();
     }
 
     virtual clock_type::time_point now() const {
@@ -99,7 +189,12 @@ public:
     }
 
     virtual worker create_worker(composite_subscription cs) const {
-        return worker(cs, std::make_shared<loop_worker>(cs, loops[++count % loops.size()], this->shared_from_this()));
+        return worker(cs, std::make_shared<loop_worker>(cs, loops, ++count % loops->slots.size(), this->shared_from_this()));
+    }
+
+    /// the number of loop threads that are currently started.
+    std::size_t running_threads() const {
+        return loops->running();
     }
 };
 
@@ -110,6 +205,9 @@ inline scheduler make_event_loop() {
 inline scheduler make_event_loop(thread_factory tf) {
     return make_scheduler<event_loop>(tf);
 }
+inline scheduler make_event_loop(thread_factory tf, std::size_t max_threads, scheduler::clock_type::duration idle_timeout) {
+    return make_scheduler<event_loop>(tf, max_threads, idle_timeout);
+}
 
 }
 
@@ -0,0 +1,372 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_SCHEDULER_FRAME_CLOCK_HPP)
+#define RXCPP_RX_SCHEDULER_FRAME_CLOCK_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace schedulers {
+
+namespace detail {
+
+struct frame_clock_waiter_list;
+
+// frame_clock_waiter is an intrusive node for callers that wait on the
+// frame clock without a schedulable, eg. coroutine awaiters. The owner
+// keeps the node alive until on_resume is called or it is cancelled.
+struct frame_clock_waiter
+{
+    typedef scheduler_base::clock_type clock_type;
+    typedef void (*resume_function)(frame_clock_waiter*);
+
+    explicit frame_clock_waiter(resume_function r)
+        : when()
+        , frame(0)
+        , on_resume(r)
+        , prev(nullptr)
+        , next(nullptr)
+        , list(nullptr)
+    {
+    }
+
+    clock_type::time_point when;
+    std::size_t frame;
+    resume_function on_resume;
+    frame_clock_waiter* prev;
+    frame_clock_waiter* next;
+    frame_clock_waiter_list* list;
+};
+
+// doubly linked so that a cancelled waiter can unlink itself in O(1).
+struct frame_clock_waiter_list
+{
+    frame_clock_waiter_list()
+        : head(nullptr)
+        , tail(nullptr)
+    {
+    }
+
+    bool empty() const {
+        return !head;
+    }
+
+    void push_back(frame_clock_waiter* w) {
+        insert_after(tail, w);
+    }
+
+    // waiters for a fixed delay arrive in deadline order, so the scan from
+    // the tail usually stops at once.
+    void insert_ordered(frame_clock_waiter* w) {
+        auto at = tail;
+        while (at && w->when < at->when) {
+            at = at->prev;
+        }
+        insert_after(at, w);
+    }
+
+    void remove(frame_clock_waiter* w) {
+        (w->prev ? w->prev->next : head) = w->next;
+        (w->next ? w->next->prev : tail) = w->prev;
+        w->prev = nullptr;
+        w->next = nullptr;
+        w->list = nullptr;
+    }
+
+    frame_clock_waiter* head;
+    frame_clock_waiter* tail;
+
+private:
+    void insert_after(frame_clock_waiter* at, frame_clock_waiter* w) {
+        w->prev = at;
+        w->next = at ? at->next : head;
+        (w->next ? w->next->prev : tail) = w;
+        (at ? at->next : head) = w;
+        w->list = this;
+    }
+};
+
+// frame_clock_state is a virtual_time whose clock only moves when the owner
+// calls advance. now() never reads the OS clock, so timed operators behave
+// the same at any frame rate, through hitches and under time dilation.
+struct frame_clock_state : public virtual_time<scheduler_base::clock_type::time_point, scheduler_base::clock_type::duration>
+{
+    typedef scheduler_base::clock_type clock_type;
+    typedef virtual_time<clock_type::time_point, clock_type::duration> base;
+
+    using base::schedule_absolute;
+
+    frame_clock_state()
+        : base(clock_type::time_point())
+        , frame(0)
+        , advancing(false)
+    {
+    }
+
+    // producers on other threads read the clock, so clock_now is only
+    // accessed with the lock held.
+    clock_type::time_point now() const {
+        std::unique_lock<std::mutex> guard(lock);
+        return base::clock_now;
+    }
+
+    /// move the clock forward by dt and run every action that is due.
+    /// virtual_time::advance_by writes the clock without the lock, this
+    /// is the same loop with the clock and the queue guarded.
+    void advance(clock_type::duration dt) const {
+        if (advancing) {
+            // advance was called from an action
+            std::terminate();
+        }
+        advancing = true;
+        rxsc::recursion r;
+        std::unique_lock<std::mutex> guard(lock);
+        auto time = base::clock_now + dt;
+        while (!base::empty()) {
+            auto next = base::top();
+            if (next.when > time) {
+                break;
+            }
+            base::pop();
+            if (!next.what.is_subscribed()) {
+                continue;
+            }
+            if (next.when > base::clock_now) {
+                base::clock_now = next.when;
+            }
+            guard.unlock();
+            next.what(r.get_recurse());
+            guard.lock();
+        }
+        base::clock_now = time;
+        guard.unlock();
+        advancing = false;
+    }
+
+    /// resume w in the first advance that reaches w.when.
+    void wait_until(frame_clock_waiter& w) const {
+        std::unique_lock<std::mutex> guard(lock);
+        timers.insert_ordered(&w);
+    }
+
+    /// resume w in the next advance.
+    void wait_frame(frame_clock_waiter& w) const {
+        std::unique_lock<std::mutex> guard(lock);
+        w.frame = frame;
+        frames.push_back(&w);
+    }
+
+    /// unlink w if it has not been resumed yet.
+    void cancel(frame_clock_waiter& w) const {
+        std::unique_lock<std::mutex> guard(lock);
+        if (w.list) {
+            w.list->remove(&w);
+        }
+    }
+
+    // waiters are popped one at a time so that a resumed caller may add or
+    // cancel other waiters.
+    void resume_waiters() const {
+        std::unique_lock<std::mutex> guard(lock);
+        auto current = frame++;
+        for (;;) {
+            frame_clock_waiter* w = nullptr;
+            if (!frames.empty() && frames.head->frame <= current) {
+                w = frames.head;
+                frames.remove(w);
+            } else if (!timers.empty() && timers.head->when <= base::clock_now) {
+                w = timers.head;
+                timers.remove(w);
+            } else {
+                break;
+            }
+            guard.unlock();
+            w->on_resume(w);
+            guard.lock();
+        }
+    }
+
+    virtual void schedule_absolute(clock_type::time_point when, const schedulable& a) const
+    {
+        // producers on other threads may schedule onto the frame clock,
+        // only the thread calling advance runs the queue.
+        std::unique_lock<std::mutex> guard(lock);
+        base::schedule_absolute(when, a);
+    }
+
+    virtual void schedule_relative(clock_type::duration when, const schedulable& a) const
+    {
+        schedule_absolute(now() + when, a);
+    }
+
+    virtual clock_type::time_point add(clock_type::time_point absolute, clock_type::duration relative) const
+    {
+        return absolute + relative;
+    }
+
+    virtual clock_type::time_point to_time_point(clock_type::time_point absolute) const
+    {
+        return absolute;
+    }
+
+    virtual clock_type::duration to_relative(clock_type::duration d) const
+    {
+        return d;
+    }
+
+protected:
+    virtual item_type top() const {
+        std::unique_lock<std::mutex> guard(lock);
+        return base::top();
+    }
+    virtual void pop() const {
+        std::unique_lock<std::mutex> guard(lock);
+        base::pop();
+    }
+    virtual bool empty() const {
+        std::unique_lock<std::mutex> guard(lock);
+        return base::empty();
+    }
+
+private:
+    mutable std::mutex lock;
+    mutable std::size_t frame;
+    // only read and written by the thread that calls advance.
+    mutable bool advancing;
+    mutable frame_clock_waiter_list frames;
+    mutable frame_clock_waiter_list timers;
+};
+
+}
+
+struct frame_clock_scheduler : public scheduler_interface
+{
+private:
+    typedef frame_clock_scheduler this_type;
+    frame_clock_scheduler(const this_type&);
+
+    struct frame_clock_worker : public worker_interface
+    {
+    private:
+        typedef frame_clock_worker this_type;
+        frame_clock_worker(const this_type&);
+
+    public:
+        std::shared_ptr<detail::frame_clock_state> state;
+
+        virtual ~frame_clock_worker()
+        {
+        }
+
+        explicit frame_clock_worker(std::shared_ptr<detail::frame_clock_state> st)
+            : state(std::move(st))
+        {
+        }
+
+        virtual clock_type::time_point now() const {
+            return state->now();
+        }
+
+        virtual void schedule(const schedulable& scbl) const {
+            state->schedule_absolute(state->now(), scbl);
+        }
+
+        virtual void schedule(clock_type::time_point when, const schedulable& scbl) const {
+            state->schedule_absolute(when, scbl);
+        }
+    };
+
+    std::shared_ptr<detail::frame_clock_state> state;
+
+public:
+    explicit frame_clock_scheduler(std::shared_ptr<detail::frame_clock_state> st)
+        : state(std::move(st))
+    {
+    }
+    virtual ~frame_clock_scheduler()
+    {
+    }
+
+    virtual clock_type::time_point now() const {
+        return state->now();
+    }
+
+    virtual worker create_worker(composite_subscription cs) const {
+        return worker(cs, std::make_shared<frame_clock_worker>(state));
+    }
+};
+
+/*!
+    \brief a scheduler whose clock is advanced by the game loop instead of the OS clock.
+
+    Call advance() once per frame with the frame delta time. Every action that
+    is due at or before the new clock time is run in order before advance()
+    returns, including actions that were scheduled by other actions during the
+    same call. Waiters added with wait_frame() and wait_until() are resumed
+    after the scheduled actions. A zero or negative step, eg. while the game is
+    paused, leaves the clock and the scheduled actions alone but still counts a
+    frame and resumes the frame waiters.
+
+    \ingroup group-core
+
+*/
+class frame_clock
+{
+private:
+    typedef frame_clock this_type;
+    frame_clock(const this_type&);
+    frame_clock(this_type&&);
+
+    std::shared_ptr<detail::frame_clock_state> state;
+    std::shared_ptr<frame_clock_scheduler> sc;
+
+public:
+    typedef scheduler::clock_type clock_type;
+
+    frame_clock()
+        : state(std::make_shared<detail::frame_clock_state>())
+        , sc(std::make_shared<frame_clock_scheduler>(state))
+    {
+    }
+
+    clock_type::time_point now() const {
+        return state->now();
+    }
+
+    /// advance the clock by one frame step and run every action that became due.
+    template<class Rep, class Period>
+    void advance(std::chrono::duration<Rep, Period> dt) const {
+        auto step = std::chrono::duration_cast<clock_type::duration>(dt);
+        if (step > clock_type::duration::zero()) {
+            state->advance(step);
+        }
+        state->resume_waiters();
+    }
+
+    /// advance the clock by one frame step given in seconds (eg. DeltaTime).
+    void advance(float seconds) const {
+        advance(std::chrono::duration<float>(seconds));
+    }
+
+    scheduler get_scheduler() const {
+        return make_scheduler(sc);
+    }
+
+    /// the underlying virtual_time, for single threaded tests that want to drive the clock with advance_to/advance_by/start.
+    const detail::frame_clock_state& get_virtual_time() const {
+        return *state;
+    }
+};
+
+inline scheduler make_frame_clock(const frame_clock& fc) {
+    return fc.get_scheduler();
+}
+
+}
+
+}
+
+#endif
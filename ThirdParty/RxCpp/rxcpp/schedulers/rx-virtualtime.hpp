@@ -44,7 +44,7 @@ protected:
 
     mutable absolute clock_now;
 
-    typedef time_schedulable<long> item_type;
+    typedef time_schedulable<absolute> item_type;
 
     virtual absolute add(absolute, relative) const =0;
 
@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_SOURCES_RX_REPLAY_FROM_HPP)
+#define RXCPP_SOURCES_RX_REPLAY_FROM_HPP
+
+#include "../rx-includes.hpp"
+#include "../rx-recorder.hpp"
+
+/*! \file rx-replay_from.hpp
+
+    \brief Returns an observable that re-emits the values of one stream from a flight_recorder file.
+
+    \tparam T             the type of the recorded values
+    \tparam Coordination  the type of the scheduler (optional)
+
+    \param  path    the file written by a flight_recorder
+    \param  stream  the id the values were recorded with
+    \param  cn      the scheduler to replay on with the original spacing between values (optional)
+
+    \return  Observable that sends each recorded value and then completes. Without
+             a scheduler the values are sent immediately, as fast as possible.
+
+*/
+
+namespace rxcpp {
+
+namespace sources {
+
+namespace detail {
+
+template<class T, class Coordination>
+struct replay_from : public source_base<rxu::decay_t<T>>
+{
+    typedef replay_from<T, Coordination> this_type;
+
+    typedef rxu::decay_t<T> value_type;
+    typedef rxu::decay_t<Coordination> coordination_type;
+    typedef typename coordination_type::coordinator_type coordinator_type;
+    typedef std::vector<recorder::recorded_value<value_type>> records_type;
+
+    struct replay_from_initial_type
+    {
+        replay_from_initial_type(std::string p, std::uint32_t s, bool t, coordination_type cn)
+            : path(std::move(p))
+            , stream(s)
+            , timed(t)
+            , coordination(std::move(cn))
+        {
+        }
+        std::string path;
+        std::uint32_t stream;
+        bool timed;
+        coordination_type coordination;
+    };
+    replay_from_initial_type initial;
+
+    replay_from(std::string p, std::uint32_t s, bool timed, coordination_type cn)
+        : initial(std::move(p), s, timed, std::move(cn))
+    {
+    }
+
+    template<class Subscriber>
+    void on_subscribe(Subscriber o) const {
+        static_assert(is_subscriber<Subscriber>::value, "subscribe must be passed a subscriber");
+
+        typedef typename coordinator_type::template get<Subscriber>::type output_type;
+
+        struct replay_from_state_type
+            : public replay_from_initial_type
+        {
+            replay_from_state_type(const replay_from_initial_type& i, rxsc::scheduler::clock_type::time_point start, output_type o)
+                : replay_from_initial_type(i)
+                , records(std::make_shared<records_type>(recorder::read_recording<value_type>(i.path, i.stream)))
+                , cursor(0)
+                , start(start)
+                , out(std::move(o))
+            {
+            }
+            std::shared_ptr<records_type> records;
+            mutable std::size_t cursor;
+            rxsc::scheduler::clock_type::time_point start;
+            mutable output_type out;
+        };
+
+        // creates a worker whose lifetime is the same as this subscription
+        auto coordinator = initial.coordination.create_coordinator(o.get_subscription());
+
+        auto controller = coordinator.get_worker();
+
+        replay_from_state_type state(initial, controller.now(), o);
+
+        auto producer = [state, controller](const rxsc::schedulable& self){
+            auto& records = *state.records;
+
+            if (!state.out.is_subscribed()) {
+                // terminate loop
+                return;
+            }
+
+            if (state.cursor != records.size()) {
+                // send next value
+                state.out.on_next(records[state.cursor].value);
+                ++state.cursor;
+            }
+
+            if (state.cursor == records.size()) {
+                state.out.on_completed();
+                // o is unsubscribed
+                return;
+            }
+
+            if (state.timed) {
+                // keep the recorded spacing relative to the first record
+                controller.schedule(state.start + (records[state.cursor].time - records.front().time), self);
+                return;
+            }
+
+            // tail recurse this same action to continue loop
+            self();
+        };
+        auto selectedProducer = on_exception(
+            [&](){return coordinator.act(producer);},
+            o);
+        if (selectedProducer.empty()) {
+            return;
+        }
+        controller.schedule(selectedProducer.get());
+    }
+};
+
+}
+
+/*! @copydoc rx-replay_from.hpp
+ */
+template<class T>
+auto replay_from(std::string path, std::uint32_t stream)
+    ->      observable<T, detail::replay_from<T, identity_one_worker>> {
+    return  observable<T, detail::replay_from<T, identity_one_worker>>(
+                              detail::replay_from<T, identity_one_worker>(std::move(path), stream, false, identity_immediate()));
+}
+/*! @copydoc rx-replay_from.hpp
+ */
+template<class T, class Coordination>
+auto replay_from(std::string path, std::uint32_t stream, Coordination cn)
+    ->      observable<T, detail::replay_from<T, Coordination>> {
+    return  observable<T, detail::replay_from<T, Coordination>>(
+                              detail::replay_from<T, Coordination>(std::move(path), stream, true, std::move(cn)));
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Open Technologies, Inc. All rights reserved. See License.txt in the project root for license information.
+
+#pragma once
+
+#if !defined(RXCPP_RX_FRAME_INPUT_HPP)
+#define RXCPP_RX_FRAME_INPUT_HPP
+
+#include "../rx-includes.hpp"
+
+namespace rxcpp {
+
+namespace subjects {
+
+namespace detail {
+
+template<class T>
+struct frame_input_state
+{
+    typedef std::pair<double, T> event_type;
+
+    frame_input_state(const rxsc::frame_clock& fc)
+        : worker(fc.get_scheduler().create_worker(lifetime))
+        , last_seconds(0)
+        , started(false)
+    {
+    }
+
+    subject<T> events;
+    composite_subscription lifetime;
+    rxsc::worker worker;
+
+    mutable std::mutex lock;
+    mutable std::vector<event_type> pending;
+    mutable std::vector<event_type> flushing;
+    mutable double last_seconds;
+    mutable bool started;
+};
+
+}
+
+/*!
+    \brief a queue of input events that are replayed on a frame_clock at the time they happened.
+
+    Input handlers push() each event with its timestamp in seconds, from any
+    thread. Once per frame, before frame_clock::advance(dt), flush() spreads the
+    events that arrived since the previous flush over the coming frame in
+    proportion to their timestamps and schedules them on the frame clock. The
+    advance then emits them in order, interleaved with the timers of the frame,
+    and the frame clock reads the time of the event while it is emitted. A press
+    and a release within one frame are both seen, and operators that use the
+    frame clock time the events by their timestamps instead of the frame.
+
+    \ingroup group-core
+*/
+template<class T>
+class frame_input
+{
+    typedef frame_input<T> this_type;
+    frame_input(const this_type&);
+
+    std::shared_ptr<detail::frame_input_state<T>> state;
+
+public:
+    typedef rxsc::scheduler::clock_type clock_type;
+
+    explicit frame_input(const rxsc::frame_clock& fc)
+        : state(std::make_shared<detail::frame_input_state<T>>(fc))
+    {
+    }
+    ~frame_input()
+    {
+        state->lifetime.unsubscribe();
+    }
+
+    /// queue an event that happened at seconds, on the same clock that is passed to flush.
+    void push(T value, double seconds) const {
+        std::unique_lock<std::mutex> guard(state->lock);
+        state->pending.emplace_back(seconds, std::move(value));
+    }
+
+    /// schedule the queued events inside the frame of length dt that the next advance(dt) runs.
+    void flush(float dt, double now_seconds) const {
+        auto& flushing = state->flushing;
+        {
+            std::unique_lock<std::mutex> guard(state->lock);
+            std::swap(flushing, state->pending);
+        }
+
+        auto last_seconds = state->started ? state->last_seconds : now_seconds;
+        state->last_seconds = now_seconds;
+        state->started = true;
+
+        auto frame_start = state->worker.now();
+        auto frame = std::chrono::duration_cast<clock_type::duration>(std::chrono::duration<float>(std::max(dt, 0.f)));
+        auto span = now_seconds - last_seconds;
+
+        for (auto& e : flushing) {
+            // events from before the previous flush start the frame, late ones end it
+            auto fraction = span > 0 ? (e.first - last_seconds) / span : 1.0;
+            fraction = std::min(std::max(fraction, 0.0), 1.0);
+            auto when = frame_start + std::chrono::duration_cast<clock_type::duration>(frame * fraction);
+
+            auto events = state->events;
+            auto value = std::move(e.second);
+            state->worker.schedule(when, [events, value](const rxsc::schedulable&){
+                events.get_subscriber().on_next(value);
+            });
+        }
+        flushing.clear();
+    }
+
+    observable<T> get_observable() const {
+        return state->events.get_observable();
+    }
+};
+
+}
+
+}
+
+#endif